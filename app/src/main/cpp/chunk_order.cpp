@@ -0,0 +1,40 @@
+#include "chunk_order.h"
+
+static const int FEISTEL_ROUNDS = 4;
+
+// دالة الجولة: خلط splitmix64 للنصف الأيمن مع المفتاح ورقم الجولة
+static uint64_t round_function(uint64_t key, int round, uint64_t x) {
+    uint64_t z = x + key + 0x9E3779B97F4A7C15ull * (uint64_t)(round + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+ChunkOrder::ChunkOrder(uint64_t count, uint64_t key) : count_(count), key_(key) {
+    // أقل عدد بتات يغطي count، مقربًا إلى زوجي حتى يتساوى النصفان. المجال أقل من 4*count،
+    // فمتوسط خطوات cycle-walking أقل من 4 لكل قطعة
+    unsigned bits = 0;
+    while (bits < 64 && (count - 1) >> bits) ++bits;
+    if (bits < 2) bits = 2;
+    half_bits_ = (bits + 1) / 2;
+    half_mask_ = (1ull << half_bits_) - 1;
+}
+
+uint64_t ChunkOrder::feistel(uint64_t x) const {
+    uint64_t left = x >> half_bits_;
+    uint64_t right = x & half_mask_;
+    for (int r = 0; r < FEISTEL_ROUNDS; ++r) {
+        uint64_t next = left ^ (round_function(key_, r, right) & half_mask_);
+        left = right;
+        right = next;
+    }
+    return (left << half_bits_) | right;
+}
+
+uint64_t ChunkOrder::at(uint64_t position) const {
+    if (linear()) return position;
+    // الـ Feistel تبديل على المجال كله، فتكرار تطبيقه من موضع داخل [0, count) يعود إلى [0, count)
+    uint64_t x = feistel(position);
+    while (x >= count_) x = feistel(x);
+    return x;
+}
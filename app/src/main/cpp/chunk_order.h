@@ -0,0 +1,28 @@
+#pragma once
+
+// ترتيب زيارة قطع النطاق. الخطي يزورها من start صعودًا، فالتشغيل الجزئي يغطي دائمًا أسفل النطاق.
+// العشوائي تبديل بمفتاح لأرقام القطع [0, count): شبكة Feistel متوازنة بأربع جولات على أصغر مجال
+// 2^(2h) >= count، مع cycle-walking لإعادة الناتج إلى [0, count). كل قطعة تُزار مرة واحدة بالضبط،
+// والمفاتيح داخل القطعة تبقى متتالية فيمشيها EcGroupWalk بالجمع التزايدي كالمعتاد.
+
+#include <cstdint>
+
+class ChunkOrder {
+public:
+    // خطي
+    ChunkOrder() = default;
+    // تبديل بالمفتاح key لـ count قطعة
+    ChunkOrder(uint64_t count, uint64_t key);
+
+    bool linear() const { return half_bits_ == 0; }
+    // رقم القطعة في الموضع position من ترتيب الزيارة، position < count
+    uint64_t at(uint64_t position) const;
+
+private:
+    uint64_t feistel(uint64_t x) const;
+
+    uint64_t count_ = 0;
+    uint64_t key_ = 0;
+    unsigned half_bits_ = 0;    // 0: خطي
+    uint64_t half_mask_ = 0;
+};
@@ -0,0 +1,141 @@
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+// حد أنوية الأداء: 80% من أعلى سعة يشمل prime و big ويستبعد LITTLE (عادة 25-45%)
+static const int PERFORMANCE_CAPACITY_PERCENT = 80;
+
+static bool read_long(const std::string& path, long& value) {
+    FILE* f = fopen(path.c_str(), "r");
+    if (f == nullptr) return false;
+    bool ok = fscanf(f, "%ld", &value) == 1;
+    fclose(f);
+    return ok;
+}
+
+// قائمة بصيغة "0-3,5,7-8"
+static std::vector<int> read_cpu_list(const std::string& path) {
+    std::vector<int> cpus;
+    FILE* f = fopen(path.c_str(), "r");
+    if (f == nullptr) return cpus;
+    char buf[256];
+    if (fgets(buf, sizeof(buf), f) != nullptr) {
+        const char* p = buf;
+        while (*p) {
+            char* end;
+            long a = strtol(p, &end, 10);
+            if (end == p) break;
+            long b = a;
+            p = end;
+            if (*p == '-') {
+                b = strtol(p + 1, &end, 10);
+                p = end;
+            }
+            for (long c = a; c <= b; ++c) cpus.push_back((int)c);
+            if (*p == ',') ++p;
+            else break;
+        }
+    }
+    fclose(f);
+    return cpus;
+}
+
+bool CpuTopology::is_performance(const CpuCore& core) const {
+    int max_capacity = 0;
+    for (const CpuCore& c : cores) max_capacity = std::max(max_capacity, c.capacity);
+    return core.capacity * 100 >= max_capacity * PERFORMANCE_CAPACITY_PERCENT;
+}
+
+bool CpuTopology::heterogeneous() const {
+    for (const CpuCore& c : cores) {
+        if (c.capacity != cores.front().capacity) return true;
+    }
+    return false;
+}
+
+CpuTopology cpu_topology_detect(const std::string& sysfs) {
+    CpuTopology topo;
+    std::vector<int> online = read_cpu_list(sysfs + "/online");
+
+    std::vector<long> freq(online.size(), 0);
+    std::vector<int> cluster(online.size(), -1);
+    bool have_capacity = true, have_freq = true;
+    for (size_t i = 0; i < online.size(); ++i) {
+        const std::string dir = sysfs + "/cpu" + std::to_string(online[i]);
+        CpuCore core;
+        core.cpu = online[i];
+
+        long value;
+        core.package = read_long(dir + "/topology/physical_package_id", value) ? (int)value : 0;
+        if (read_long(dir + "/topology/cluster_id", value) && value >= 0) cluster[i] = (int)value;
+        core.core_id = read_long(dir + "/topology/core_id", value) ? (int)value : core.cpu;
+
+        // الشقيق الأول في thread_siblings_list هو الممثل الفيزيائي للنواة
+        std::vector<int> siblings = read_cpu_list(dir + "/topology/thread_siblings_list");
+        core.smt_primary = siblings.empty() || *std::min_element(siblings.begin(), siblings.end()) == core.cpu;
+
+        if (read_long(dir + "/cpu_capacity", value)) core.capacity = (int)value;
+        else have_capacity = false;
+        if (read_long(dir + "/cpufreq/cpuinfo_max_freq", value)) freq[i] = value;
+        else have_freq = false;
+
+        topo.cores.push_back(core);
+    }
+
+    if (topo.cores.empty()) {
+        unsigned n = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < n; ++i) topo.cores.push_back(CpuCore{-1, 0, (int)i, 1024, true});
+        return topo;
+    }
+
+    // cluster_id يفصل LITTLE عن big داخل حزمة الهاتف الواحدة، لكنه على x86 قد يتكرر بين الحزم
+    // (أو يكون واحدًا لكل الأنوية)، فلا يُستعمل إلا إن ميّز أنوية داخل نفس الحزمة
+    std::map<int, std::set<int>> package_clusters;
+    for (size_t i = 0; i < topo.cores.size(); ++i) package_clusters[topo.cores[i].package].insert(cluster[i]);
+    std::map<std::pair<int, int>, int> groups;
+    for (size_t i = 0; i < topo.cores.size(); ++i) {
+        CpuCore& core = topo.cores[i];
+        const int split = package_clusters[core.package].size() > 1 ? cluster[i] : -1;
+        auto group = groups.emplace(std::make_pair(core.package, split), (int)groups.size()).first;
+        core.package = group->second;
+    }
+
+    if (!have_capacity) {
+        // دون cpu_capacity: التردد الأقصى مقياس تقريبي للسعة، وإلا فالأنوية متساوية
+        long max_freq = have_freq ? *std::max_element(freq.begin(), freq.end()) : 0;
+        for (size_t i = 0; i < topo.cores.size(); ++i)
+            topo.cores[i].capacity = max_freq > 0 ? (int)(freq[i] * 1024 / max_freq) : 1024;
+    }
+
+    // الأسرع أولًا، ثم الأنوية الفيزيائية قبل أشقاء SMT، فيأخذ أول N عامل أفضل N نواة
+    std::stable_sort(topo.cores.begin(), topo.cores.end(), [](const CpuCore& a, const CpuCore& b) {
+        if (a.smt_primary != b.smt_primary) return a.smt_primary;
+        return a.capacity > b.capacity;
+    });
+    return topo;
+}
+
+bool cpu_pin_current_thread(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    // pid 0 = الخيط الحالي على لينكس وأندرويد
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+// اكتشاف أنوية المعالج من /sys: السعة النسبية (cpu_capacity على أندرويد/ARM أو أقصى تردد
+// كبديل)، وتخطيط الحزمة/النواة/SMT على أجهزة لينكس. يُستخدم لتثبيت خيوط العمل على الأنوية
+// وترتيبها: الأنوية الفيزيائية الأسرع أولًا ثم أشقاء SMT.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct CpuCore {
+    int cpu;                // رقم المعالج المنطقي
+    int package;            // رقم مجموعة الأنوية من 0: الحزمة، مقسومة بـ cluster_id إن ميّز أنوية داخلها
+    int core_id;
+    int capacity;           // نسبي، الأسرع = 1024
+    bool smt_primary;       // أول شقيق في نواته الفيزيائية
+};
+
+struct CpuTopology {
+    std::vector<CpuCore> cores;     // الأنوية الفيزيائية (الأسرع أولًا) ثم أشقاء SMT
+
+    // أنوية الأداء: سعتها قريبة من الأعلى (prime + big على الهواتف، كل الأنوية على جهاز متجانس)
+    bool is_performance(const CpuCore& core) const;
+    bool heterogeneous() const;
+};
+
+// يقرأ sysfs (جذر آخر للاختبار بشجرة مزيفة). إن تعذر ذلك يعيد hardware_concurrency() أنوية متساوية
+// دون أرقام معالج
+CpuTopology cpu_topology_detect(const std::string& sysfs = "/sys/devices/system/cpu");
+
+// يثبت الخيط الحالي على معالج واحد. يعيد false إن رفض النظام أو لم يكن مدعومًا
+bool cpu_pin_current_thread(int cpu);
@@ -0,0 +1,150 @@
+#include "ec_batch.h"
+
+bool fe_batch_inv(FieldElem* elems, size_t n, FieldElem* scratch) {
+    if (n == 0) return true;
+
+    // scratch[i] = elems[0] * ... * elems[i]
+    scratch[0] = elems[0];
+    for (size_t i = 1; i < n; ++i) fe_mul(scratch[i], scratch[i - 1], elems[i]);
+    if (fe_is_zero(scratch[n - 1])) return false;
+
+    FieldElem inv;
+    fe_inv(inv, scratch[n - 1]);
+    for (size_t i = n - 1; i > 0; --i) {
+        FieldElem elem_inv;
+        fe_mul(elem_inv, inv, scratch[i - 1]);
+        fe_mul(inv, inv, elems[i]);
+        elems[i] = elem_inv;
+    }
+    elems[0] = inv;
+    return true;
+}
+
+// r = a + (bx, by) حين يكون معكوس (bx - a.x) محسوبًا مسبقًا
+// rx/ry قد تكون a.x/a.y نفسها: النتيجة تُكتب في النهاية
+static inline void affine_add_with_inv(FieldElem& rx, FieldElem& ry, const AffinePoint& a, const FieldElem& bx,
+                                       const FieldElem& by, const FieldElem& dx_inv) {
+    FieldElem lambda, x3, y3;
+    fe_sub(lambda, by, a.y);
+    fe_mul(lambda, lambda, dx_inv);
+    fe_sqr(x3, lambda);
+    fe_sub(x3, x3, a.x);
+    fe_sub(x3, x3, bx);         // x3 = λ^2 - x1 - x2
+    fe_sub(y3, a.x, x3);
+    fe_mul(y3, y3, lambda);
+    fe_sub(y3, y3, a.y);        // y3 = λ(x1 - x3) - y1
+    rx = x3;
+    ry = y3;
+}
+
+void ec_batch_to_affine(AffinePoint* out, const JacobianPoint* in, size_t n) {
+    std::vector<FieldElem> z(n), scratch(n);
+    size_t m = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!in[i].infinity) z[m++] = in[i].z;
+    }
+    fe_batch_inv(z.data(), m, scratch.data());
+
+    m = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (in[i].infinity) {
+            out[i].infinity = true;
+            continue;
+        }
+        const FieldElem& zinv = z[m++];
+        FieldElem zinv2, zinv3;
+        fe_sqr(zinv2, zinv);
+        fe_mul(zinv3, zinv2, zinv);
+        fe_mul(out[i].x, in[i].x, zinv2);
+        fe_mul(out[i].y, in[i].y, zinv3);
+        out[i].infinity = false;
+    }
+}
+
+std::vector<AffinePoint> ec_generator_multiples(size_t n) {
+    std::vector<JacobianPoint> jac(n);
+    JacobianPoint acc;
+    acc.infinity = true;
+    for (size_t i = 0; i < n; ++i) {
+        ec_jacobian_add_affine(acc, acc, SECP256K1_G);
+        jac[i] = acc;
+    }
+    std::vector<AffinePoint> out(n);
+    ec_batch_to_affine(out.data(), jac.data(), n);
+    return out;
+}
+
+bool ec_batch_add_mul_generator(AffinePoint* acc, const U256* scalars, size_t n, const GeneratorTable& table,
+                                FieldElem* dx, FieldElem* scratch) {
+    static const FieldElem ONE = {{1, 0, 0, 0}};
+    for (size_t j = 0; j < GEN_TABLE_WINDOWS; ++j) {
+        const AffinePoint* window = table.window(j);
+        const unsigned shift = (unsigned)(j % 8) * 8;
+        // البايت 0 لا يجمع شيئًا: عنصر 1 في الانعكاس المشترك بدل الفرق
+        for (size_t i = 0; i < n; ++i) {
+            unsigned v = (unsigned)(scalars[i].d[j / 8] >> shift) & 0xFF;
+            if (v != 0) fe_sub(dx[i], window[v - 1].x, acc[i].x);
+            else dx[i] = ONE;
+        }
+        if (!fe_batch_inv(dx, n, scratch)) return false;
+        for (size_t i = 0; i < n; ++i) {
+            unsigned v = (unsigned)(scalars[i].d[j / 8] >> shift) & 0xFF;
+            if (v == 0) continue;
+            const AffinePoint& w = window[v - 1];
+            affine_add_with_inv(acc[i].x, acc[i].y, acc[i], w.x, w.y, dx[i]);
+        }
+    }
+    return true;
+}
+
+EcGroupWalk::EcGroupWalk(const GeneratorTable& table, size_t group_size)
+    : table_(table), multiples_(table.multiples()), group_size_(group_size), scratch_(group_size + 2) {
+    centre_.infinity = true;
+    table_.mul_generator(step_, u256_from_u64(group_size));
+}
+
+void EcGroupWalk::reset(const U256& start) {
+    U256 centre;
+    u256_add_u64(centre, start, group_size_ / 2);
+    table_.mul_generator(centre_, centre);
+}
+
+void EcGroupWalk::next_group(FieldElem* xs, FieldElem* ys) {
+    // المركز C يقابل المؤشر half. C + iG و C - iG لهما نفس فرق x، فالانعكاس الواحد
+    // يخدم الاتجاهين، والعنصر الأخير للانتقال إلى مركز المجموعة التالية C + group_size*G.
+    // في الحجم الزوجي يقصر الجانب الموجب نقطة واحدة (upper = half - 1)
+    const size_t half = group_size_ / 2, upper = group_size_ - 1 - half;
+    FieldElem* dx = scratch_.data() + half + 1;
+    for (size_t i = 0; i < half; ++i) fe_sub(dx[i], multiples_[i].x, centre_.x);
+    fe_sub(dx[half], step_.x, centre_.x);
+
+    xs[half] = centre_.x;
+    ys[half] = centre_.y;
+    if (centre_.infinity || !fe_batch_inv(dx, half + 1, scratch_.data())) {
+        // C = ±iG: حالة نادرة قرب بداية المنحنى أو نهايته، نجمع بالطريقة العادية
+        AffinePoint p;
+        for (size_t i = 1; i <= half; ++i) {
+            AffinePoint neg = multiples_[i - 1];
+            fe_neg(neg.y, neg.y);
+            if (i <= upper) {
+                ec_affine_add(p, centre_, multiples_[i - 1]);
+                xs[half + i] = p.x;
+                ys[half + i] = p.y;
+            }
+            ec_affine_add(p, centre_, neg);
+            xs[half - i] = p.x;
+            ys[half - i] = p.y;
+        }
+        ec_affine_add(centre_, centre_, step_);
+        return;
+    }
+
+    for (size_t i = 1; i <= half; ++i) {
+        const AffinePoint& m = multiples_[i - 1];
+        if (i <= upper) affine_add_with_inv(xs[half + i], ys[half + i], centre_, m.x, m.y, dx[i - 1]);
+        FieldElem neg_y;
+        fe_neg(neg_y, m.y);
+        affine_add_with_inv(xs[half - i], ys[half - i], centre_, m.x, neg_y, dx[i - 1]);
+    }
+    affine_add_with_inv(centre_.x, centre_.y, centre_, step_.x, step_.y, dx[half]);
+}
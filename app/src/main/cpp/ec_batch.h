@@ -0,0 +1,49 @@
+#pragma once
+
+// عمليات secp256k1 على دفعات تشترك في انعكاس حقلي واحد (حيلة Montgomery):
+// n انعكاس = انعكاس واحد + 3(n-1) ضرب، وهو ما يجعل جمع النقاط affine رخيصًا.
+
+#include <cstddef>
+#include <vector>
+
+#include "gen_table.h"
+#include "secp256k1.h"
+
+// يعكس elems[0..n-1] في مكانها. scratch بطول n على الأقل.
+// يعيد false (دون تعديل) إن كان أحد العناصر صفرًا.
+bool fe_batch_inv(FieldElem* elems, size_t n, FieldElem* scratch);
+
+void ec_batch_to_affine(AffinePoint* out, const JacobianPoint* in, size_t n);
+
+// [1G, 2G, ..., nG] بصيغة affine
+std::vector<AffinePoint> ec_generator_multiples(size_t n);
+
+// acc[i] += scalars[i]*G لكل i بنوافذ الجدول: في كل نافذة جمع affine لكل النقاط بانعكاس مشترك،
+// فيكلف المفتاح ~6 ضربات للنافذة بدل ~12 في الجمع المختلط. dx و scratch بطول n.
+// يعيد false إن صادف جمعًا منحلًا (acc = ±نقطة النافذة، احتماله مهمل)، و acc حينها غير محددة
+bool ec_batch_add_mul_generator(AffinePoint* acc, const U256* scalars, size_t n, const GeneratorTable& table,
+                                FieldElem* dx, FieldElem* scratch);
+
+// مشي نطاق متصل على مجموعات بحجم group_size (أي حجم >= 1) حول نقطة مركزية C:
+// النقاط C ± iG تشترك في نفس فروق x، فتكلف المجموعة group_size/2 + 1 انعكاسًا مدمجًا في واحد.
+// الجدول يجب أن يبقى صالحًا طوال عمر المشي، و group_size/2 <= GEN_TABLE_MULTIPLES.
+class EcGroupWalk {
+public:
+    EcGroupWalk(const GeneratorTable& table, size_t group_size);
+
+    void reset(const U256& start);
+
+    // يملأ xs/ys[0..group_size-1] بإحداثيات نقاط k .. k+group_size-1 ثم يتقدم group_size مفتاحًا.
+    // xs/ys[j] تقابل المفتاح k + j، سواء حُسبت من جهة C + iG أو C - iG.
+    void next_group(FieldElem* xs, FieldElem* ys);
+
+    size_t group_size() const { return group_size_; }
+
+private:
+    const GeneratorTable& table_;
+    const AffinePoint* multiples_;
+    size_t group_size_;
+    AffinePoint centre_;
+    AffinePoint step_;        // group_size*G
+    std::vector<FieldElem> scratch_;
+};
@@ -0,0 +1,203 @@
+#include "gen_table.h"
+
+#include <android/log.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "ec_batch.h"
+
+#define LOG_TAG "KeySearch"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+
+static const char GEN_TABLE_MAGIC[8] = {'K', 'S', 'G', 'T', 'A', 'B', 'L', 'E'};
+static const uint32_t GEN_TABLE_VERSION = 1;
+static const size_t GEN_TABLE_POINTS = GEN_TABLE_MULTIPLES + GEN_TABLE_WINDOWS * GEN_TABLE_WINDOW_SIZE;
+
+// الترويسة تسبق النقاط مباشرة؛ حجمها 64 بايت حتى تبقى النقاط محاذاة
+struct GenTableHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t point_size;      // sizeof(AffinePoint) لهذه المعمارية
+    uint32_t multiples;
+    uint32_t windows;
+    uint32_t window_size;
+    uint32_t crc32;           // CRC-32 لبيانات النقاط
+    uint64_t payload_size;
+    unsigned char reserved[24];
+};
+static_assert(sizeof(GenTableHeader) == 64, "header layout");
+
+static void fill_header(GenTableHeader& h) {
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, GEN_TABLE_MAGIC, sizeof(h.magic));
+    h.version = GEN_TABLE_VERSION;
+    h.point_size = sizeof(AffinePoint);
+    h.multiples = GEN_TABLE_MULTIPLES;
+    h.windows = GEN_TABLE_WINDOWS;
+    h.window_size = GEN_TABLE_WINDOW_SIZE;
+    h.payload_size = GEN_TABLE_POINTS * sizeof(AffinePoint);
+}
+
+static uint32_t payload_crc(const AffinePoint* points) {
+    const size_t size = GEN_TABLE_POINTS * sizeof(AffinePoint);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(points);
+    uLong crc = crc32(0L, Z_NULL, 0);
+    // crc32() يأخذ الطول كـ uInt، نمرر البيانات على أجزاء
+    for (size_t off = 0; off < size; off += (1u << 30)) {
+        size_t n = std::min<size_t>(size - off, 1u << 30);
+        crc = crc32(crc, p + off, (uInt)n);
+    }
+    return (uint32_t)crc;
+}
+
+static void build_points(AffinePoint* out) {
+    std::vector<AffinePoint> multiples = ec_generator_multiples(GEN_TABLE_MULTIPLES);
+    memcpy(out, multiples.data(), GEN_TABLE_MULTIPLES * sizeof(AffinePoint));
+
+    // النافذة j: v * B_j لـ v = 1..255 حيث B_j = 2^(8j) * G
+    std::vector<JacobianPoint> jac(GEN_TABLE_WINDOWS * GEN_TABLE_WINDOW_SIZE);
+    JacobianPoint base_j;
+    base_j.x = SECP256K1_G.x;
+    base_j.y = SECP256K1_G.y;
+    base_j.z = {{1, 0, 0, 0}};
+    base_j.infinity = false;
+    for (size_t j = 0; j < GEN_TABLE_WINDOWS; ++j) {
+        AffinePoint base_affine;
+        ec_jacobian_to_affine(base_affine, base_j);
+        JacobianPoint acc;
+        acc.infinity = true;
+        for (size_t v = 0; v < GEN_TABLE_WINDOW_SIZE; ++v) {
+            ec_jacobian_add_affine(acc, acc, base_affine);
+            jac[j * GEN_TABLE_WINDOW_SIZE + v] = acc;
+        }
+        for (int d = 0; d < 8; ++d) ec_jacobian_double(base_j, base_j);
+    }
+    ec_batch_to_affine(out + GEN_TABLE_MULTIPLES, jac.data(), jac.size());
+}
+
+GeneratorTable::~GeneratorTable() {
+    if (map_ != nullptr) munmap(map_, map_size_);
+}
+
+// يربط الملف إن كان سليمًا، وإلا يعيد false
+static bool map_table(const std::string& path, void** map_out, size_t* size_out) {
+    const size_t expected = sizeof(GenTableHeader) + GEN_TABLE_POINTS * sizeof(AffinePoint);
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != expected) {
+        close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, expected, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    GenTableHeader want;
+    fill_header(want);
+    const GenTableHeader* h = static_cast<const GenTableHeader*>(map);
+    const AffinePoint* points = reinterpret_cast<const AffinePoint*>(h + 1);
+    want.crc32 = h->crc32;
+    if (memcmp(h, &want, sizeof(want)) != 0 || payload_crc(points) != h->crc32) {
+        munmap(map, expected);
+        return false;
+    }
+    *map_out = map;
+    *size_out = expected;
+    return true;
+}
+
+// يكتب الجدول إلى ملف مؤقت ثم rename، فلا يرى أي قارئ ملفًا نصف مكتوب
+static bool write_table(const std::string& path, const AffinePoint* points) {
+    GenTableHeader h;
+    fill_header(h);
+    h.crc32 = payload_crc(points);
+
+    std::string tmp = path + ".tmp";
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) return false;
+
+    bool ok = write(fd, &h, sizeof(h)) == (ssize_t)sizeof(h);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(points);
+    size_t left = GEN_TABLE_POINTS * sizeof(AffinePoint);
+    while (ok && left > 0) {
+        ssize_t n = write(fd, p, left);
+        if (n <= 0) ok = false;
+        else {
+            p += n;
+            left -= (size_t)n;
+        }
+    }
+    ok = ok && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        unlink(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const GeneratorTable> GeneratorTable::open_or_build(const std::string& dir) {
+    static std::mutex cache_mutex;
+    // الجدول يبقى مربوطًا طوال عمر العملية، فالبحث التالي لا يعيد حتى فحص CRC
+    static std::map<std::string, std::shared_ptr<const GeneratorTable>> cache;
+
+    std::string path = dir;
+    if (!path.empty() && path.back() != '/') path += "/";
+    path += "secp256k1_gtable.bin";
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(path);
+    if (it != cache.end()) return it->second;
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::shared_ptr<GeneratorTable> table(new GeneratorTable());
+    bool built = false;
+    if (dir.empty() || !map_table(path, &table->map_, &table->map_size_)) {
+        // بقيمة صفرية: حشو البنية يدخل CRC والملف، فيبقى الملف نفسه في كل بناء
+        std::unique_ptr<AffinePoint[]> points(new AffinePoint[GEN_TABLE_POINTS]());
+        build_points(points.get());
+        built = true;
+        if (dir.empty() || !write_table(path, points.get()) ||
+            !map_table(path, &table->map_, &table->map_size_)) {
+            LOGI("Generator table: cannot persist %s, using heap copy", path.c_str());
+            table->heap_ = std::move(points);
+        }
+    }
+    if (table->map_ != nullptr) {
+        table->points_ = reinterpret_cast<const AffinePoint*>(static_cast<const GenTableHeader*>(table->map_) + 1);
+    } else {
+        table->points_ = table->heap_.get();
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    LOGI("Generator table %s in %.1f ms (%s)", built ? "built" : "mapped", ms, table->mapped() ? "mmap" : "heap");
+
+    cache[path] = table;
+    return table;
+}
+
+void GeneratorTable::mul_generator_jacobian(JacobianPoint& r, const U256& k) const {
+    r.infinity = true;
+    for (size_t j = 0; j < GEN_TABLE_WINDOWS; ++j) {
+        unsigned v = (unsigned)(k.d[j / 8] >> ((j % 8) * 8)) & 0xFF;
+        if (v != 0) ec_jacobian_add_affine(r, r, window(j)[v - 1]);
+    }
+}
+
+void GeneratorTable::mul_generator(AffinePoint& r, const U256& k) const {
+    JacobianPoint acc;
+    mul_generator_jacobian(acc, k);
+    ec_jacobian_to_affine(r, acc);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// جدول مضاعفات G المحسوب مسبقًا، محفوظ في ملف ويُربط بالذاكرة (mmap) للقراءة فقط.
+// يحوي:
+//   - 1G .. GEN_TABLE_MULTIPLES*G لمشي المجموعات (EcGroupWalk)
+//   - نوافذ 8-بت: v * 2^(8j) * G لكل j = 0..31 و v = 1..255، لحساب k*G ببدايات المقاطع
+// الملف يُبنى مرة واحدة، وكل الخيوط تشترك في نفس الصفحات بلا نسخة في heap.
+// إن كان مفقودًا أو تالفًا (إصدار، أبعاد، CRC) يُعاد بناؤه تلقائيًا.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "secp256k1.h"
+
+// يكفي لأكبر مجموعة مشي مدعومة (4096 مفتاحًا)
+static const size_t GEN_TABLE_MULTIPLES = 2048;
+static const size_t GEN_TABLE_WINDOWS = 32;
+static const size_t GEN_TABLE_WINDOW_SIZE = 255;
+
+class GeneratorTable {
+public:
+    ~GeneratorTable();
+
+    // يفتح dir/secp256k1_gtable.bin أو يبنيه. يعيد نفس الجدول للمسار نفسه داخل العملية.
+    // إن تعذّرت الكتابة إلى dir يُبنى الجدول في الذاكرة فقط.
+    static std::shared_ptr<const GeneratorTable> open_or_build(const std::string& dir);
+
+    // [1G, 2G, ..., GEN_TABLE_MULTIPLES*G]
+    const AffinePoint* multiples() const { return points_; }
+
+    // k*G بـ 32 جمعًا مختلطًا وانعكاس واحد
+    void mul_generator(AffinePoint& r, const U256& k) const;
+    // نفس الجمع دون الانعكاس، لمن يحول دفعة كاملة إلى affine بانعكاس مشترك
+    void mul_generator_jacobian(JacobianPoint& r, const U256& k) const;
+
+    // النافذة j: window(j)[v - 1] = v * 2^(8j) * G
+    const AffinePoint* window(size_t j) const {
+        return points_ + GEN_TABLE_MULTIPLES + j * GEN_TABLE_WINDOW_SIZE;
+    }
+
+    bool mapped() const { return map_ != nullptr; }
+
+private:
+    GeneratorTable() = default;
+    GeneratorTable(const GeneratorTable&) = delete;
+    GeneratorTable& operator=(const GeneratorTable&) = delete;
+
+    void* map_ = nullptr;
+    size_t map_size_ = 0;
+    std::unique_ptr<AffinePoint[]> heap_;   // فقط عند تعذّر الملف
+    const AffinePoint* points_ = nullptr;
+};
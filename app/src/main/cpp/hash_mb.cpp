@@ -0,0 +1,148 @@
+#include "hash_mb.h"
+#include "hash_mb_internal.h"
+#include "ripemd160_mb_kernel.h"
+#include "sha256_fixed.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HASH_MB_X86 1
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define HASH_MB_NEON 1
+#endif
+
+void sha256_mb_scalar(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]) {
+    sha256_mb_lanes<VecScalar>(msgs, len, digests);
+}
+
+void hash160_mb_scalar(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]) {
+    hash160_mb_lanes<VecScalar>(msgs, len, digests);
+}
+
+// حالة SHA-256 بعد كتلة الوسم SHA256("TapTweak") || SHA256("TapTweak") في BIP-341،
+// تُحسب مرة واحدة فيكلف كل tweak ضغطة واحدة بدل ثلاث
+const uint32_t* tap_tweak_midstate() {
+    static const struct Midstate {
+        uint32_t words[8];
+        Midstate() {
+            unsigned char tag[32];
+            sha256_fixed<8>(reinterpret_cast<const unsigned char*>("TapTweak"), tag);
+            VecScalar s[8], w[64];
+            for (int i = 0; i < 8; ++i) s[i] = VecScalar::set1(SHA256_IV[i]);
+            for (int i = 0; i < 16; ++i) w[i] = VecScalar::set1(load_be32(tag + (i % 8) * 4));
+            sha256_mb_compress(s, w);
+            for (int i = 0; i < 8; ++i) s[i].store(&words[i]);
+        }
+    } midstate;
+    return midstate.words;
+}
+
+void tap_tweak_mb_scalar(const unsigned char* const* xs, unsigned char (*tweaks)[32]) {
+    tap_tweak_mb_lanes<VecScalar>(xs, tweaks);
+}
+
+bool simd_backend_available(SimdBackend backend) {
+    switch (backend) {
+        case SimdBackend::Scalar:
+            return true;
+#if defined(HASH_MB_X86)
+        case SimdBackend::SSE41:
+            return __builtin_cpu_supports("sse4.1");
+        case SimdBackend::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+#if defined(HASH_MB_NEON)
+        case SimdBackend::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+SimdBackend simd_best_backend() {
+    static const SimdBackend best = [] {
+        if (simd_backend_available(SimdBackend::AVX2)) return SimdBackend::AVX2;
+        if (simd_backend_available(SimdBackend::SSE41)) return SimdBackend::SSE41;
+        if (simd_backend_available(SimdBackend::NEON)) return SimdBackend::NEON;
+        return SimdBackend::Scalar;
+    }();
+    return best;
+}
+
+int simd_backend_lanes(SimdBackend backend) {
+    switch (backend) {
+        case SimdBackend::SSE41: return 4;
+        case SimdBackend::AVX2: return 8;
+        case SimdBackend::NEON: return 4;
+        default: return 1;
+    }
+}
+
+const char* simd_backend_name(SimdBackend backend) {
+    switch (backend) {
+        case SimdBackend::SSE41: return "sse4.1";
+        case SimdBackend::AVX2: return "avx2";
+        case SimdBackend::NEON: return "neon";
+        default: return "scalar";
+    }
+}
+
+typedef void (*Sha256LanesFn)(const unsigned char* const*, size_t, unsigned char (*)[32]);
+typedef void (*Hash160LanesFn)(const unsigned char* const*, size_t, unsigned char (*)[20]);
+typedef void (*TapTweakLanesFn)(const unsigned char* const*, unsigned char (*)[32]);
+
+struct HashMbKernels {
+    Sha256LanesFn sha256;
+    Hash160LanesFn hash160;
+    TapTweakLanesFn tap_tweak;
+};
+
+static HashMbKernels hash_mb_kernels(SimdBackend backend) {
+    switch (backend) {
+#if defined(HASH_MB_X86)
+        case SimdBackend::SSE41: return {sha256_mb_sse41, hash160_mb_sse41, tap_tweak_mb_sse41};
+        case SimdBackend::AVX2: return {sha256_mb_avx2, hash160_mb_avx2, tap_tweak_mb_avx2};
+#endif
+#if defined(HASH_MB_NEON)
+        case SimdBackend::NEON: return {sha256_mb_neon, hash160_mb_neon, tap_tweak_mb_neon};
+#endif
+        default: return {sha256_mb_scalar, hash160_mb_scalar, tap_tweak_mb_scalar};
+    }
+}
+
+// يقسم count رسالة على استدعاءات النواة، والباقي يُكمل بتكرار آخر رسالة وتُهمل نتائجه
+template <size_t DIGEST, class Fn>
+static void run_lanes(Fn fn, size_t lanes, const unsigned char* const* msgs, size_t len, size_t count,
+                      unsigned char (*digests)[DIGEST]) {
+    size_t i = 0;
+    for (; i + lanes <= count; i += lanes) fn(msgs + i, len, digests + i);
+
+    if (i < count) {
+        const unsigned char* tail_msgs[8];
+        unsigned char tail_digests[8][DIGEST];
+        for (size_t l = 0; l < lanes; ++l) tail_msgs[l] = msgs[std::min(i + l, count - 1)];
+        fn(tail_msgs, len, tail_digests);
+        for (size_t l = 0; i + l < count; ++l) memcpy(digests[i + l], tail_digests[l], DIGEST);
+    }
+}
+
+void sha256_mb(SimdBackend backend, const unsigned char* const* msgs, size_t len, size_t count,
+               unsigned char (*digests)[32]) {
+    if (!simd_backend_available(backend)) backend = SimdBackend::Scalar;
+    run_lanes<32>(hash_mb_kernels(backend).sha256, (size_t)simd_backend_lanes(backend), msgs, len, count, digests);
+}
+
+void hash160_mb(SimdBackend backend, const unsigned char* const* msgs, size_t len, size_t count,
+                unsigned char (*digests)[20]) {
+    if (!simd_backend_available(backend)) backend = SimdBackend::Scalar;
+    run_lanes<20>(hash_mb_kernels(backend).hash160, (size_t)simd_backend_lanes(backend), msgs, len, count, digests);
+}
+
+void tap_tweak_mb(SimdBackend backend, const unsigned char* const* xs, size_t count, unsigned char (*tweaks)[32]) {
+    if (!simd_backend_available(backend)) backend = SimdBackend::Scalar;
+    TapTweakLanesFn fn = hash_mb_kernels(backend).tap_tweak;
+    auto lanes = [fn](const unsigned char* const* msgs, size_t, unsigned char (*digests)[32]) { fn(msgs, digests); };
+    run_lanes<32>(lanes, (size_t)simd_backend_lanes(backend), xs, 32, count, tweaks);
+}
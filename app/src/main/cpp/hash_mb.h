@@ -0,0 +1,27 @@
+#pragma once
+
+// تجزئة متعددة الرسائل (multi-buffer): عدة رسائل مستقلة بنفس الطول في مسارات SIMD.
+// NEON على arm64/armv7، SSE4.1 و AVX2 على x86_64، ومسار محمول لبقية الأجهزة.
+
+#include <cstddef>
+#include "simd.h"
+
+// أفضل نواة يدعمها المعالج الحالي (يُحسب مرة واحدة)
+SimdBackend simd_best_backend();
+bool simd_backend_available(SimdBackend backend);
+int simd_backend_lanes(SimdBackend backend);
+const char* simd_backend_name(SimdBackend backend);
+
+// SHA-256 لعدد count من الرسائل بطول len بايت (len <= 119)، والنتائج في digests.
+// لا يشترط أن يكون count من مضاعفات عدد المسارات.
+void sha256_mb(SimdBackend backend, const unsigned char* const* msgs, size_t len, size_t count,
+               unsigned char (*digests)[32]);
+
+// hash160 = RIPEMD160(SHA256(msg)) في خط واحد: ناتج SHA-256 يبقى في مسارات SIMD
+// ويدخل RIPEMD-160 مباشرة. نفس شروط sha256_mb على len و count.
+void hash160_mb(SimdBackend backend, const unsigned char* const* msgs, size_t len, size_t count,
+                unsigned char (*digests)[20]);
+
+// BIP-341 بلا شجرة سكربتات: tagged_hash("TapTweak", x) لعدد count من إحداثيات x-only (32 بايت).
+// تبدأ من حالة كتلة الوسم المحسوبة مسبقًا، فكل رسالة ضغطة SHA-256 واحدة
+void tap_tweak_mb(SimdBackend backend, const unsigned char* const* xs, size_t count, unsigned char (*tweaks)[32]);
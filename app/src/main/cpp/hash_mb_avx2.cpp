@@ -0,0 +1,20 @@
+// يُبنى بـ -mavx2 على x86 (انظر CMakeLists.txt)
+#if defined(__AVX2__)
+
+#include "hash_mb_internal.h"
+#include "ripemd160_mb_kernel.h"
+#include "sha256_fixed.h"
+
+void sha256_mb_avx2(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]) {
+    sha256_mb_lanes<VecAVX2>(msgs, len, digests);
+}
+
+void hash160_mb_avx2(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]) {
+    hash160_mb_lanes<VecAVX2>(msgs, len, digests);
+}
+
+void tap_tweak_mb_avx2(const unsigned char* const* xs, unsigned char (*tweaks)[32]) {
+    tap_tweak_mb_lanes<VecAVX2>(xs, tweaks);
+}
+
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+// نوى كل معمارية، تعالج كل واحدة simd_backend_lanes() رسالة في الاستدعاء.
+// المعرّفة فقط في ملفات hash_mb_*.cpp المبنية بأعلام المعالج المناسبة.
+
+#include <cstddef>
+#include <cstdint>
+
+void sha256_mb_scalar(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]);
+void sha256_mb_sse41(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]);
+void sha256_mb_avx2(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]);
+void sha256_mb_neon(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]);
+
+void hash160_mb_scalar(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]);
+void hash160_mb_sse41(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]);
+void hash160_mb_avx2(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]);
+void hash160_mb_neon(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]);
+
+void tap_tweak_mb_scalar(const unsigned char* const* xs, unsigned char (*tweaks)[32]);
+void tap_tweak_mb_sse41(const unsigned char* const* xs, unsigned char (*tweaks)[32]);
+void tap_tweak_mb_avx2(const unsigned char* const* xs, unsigned char (*tweaks)[32]);
+void tap_tweak_mb_neon(const unsigned char* const* xs, unsigned char (*tweaks)[32]);
+
+// حالة SHA-256 بعد كتلة وسم TapTweak، معرّفة مرة واحدة في hash_mb.cpp المبني بلا أعلام
+// المعالج: نسخة inline في كل ملف قد يختار الرابط منها نسخة AVX2
+const uint32_t* tap_tweak_midstate();
@@ -0,0 +1,20 @@
+// NEON مفعّل افتراضيًا في arm64-v8a و armeabi-v7a مع NDK
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include "hash_mb_internal.h"
+#include "ripemd160_mb_kernel.h"
+#include "sha256_fixed.h"
+
+void sha256_mb_neon(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]) {
+    sha256_mb_lanes<VecNEON>(msgs, len, digests);
+}
+
+void hash160_mb_neon(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]) {
+    hash160_mb_lanes<VecNEON>(msgs, len, digests);
+}
+
+void tap_tweak_mb_neon(const unsigned char* const* xs, unsigned char (*tweaks)[32]) {
+    tap_tweak_mb_lanes<VecNEON>(xs, tweaks);
+}
+
+#endif
@@ -0,0 +1,20 @@
+// يُبنى بـ -msse4.1 على x86 (انظر CMakeLists.txt)
+#if defined(__SSE4_1__)
+
+#include "hash_mb_internal.h"
+#include "ripemd160_mb_kernel.h"
+#include "sha256_fixed.h"
+
+void sha256_mb_sse41(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]) {
+    sha256_mb_lanes<VecSSE41>(msgs, len, digests);
+}
+
+void hash160_mb_sse41(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]) {
+    hash160_mb_lanes<VecSSE41>(msgs, len, digests);
+}
+
+void tap_tweak_mb_sse41(const unsigned char* const* xs, unsigned char (*tweaks)[32]) {
+    tap_tweak_mb_lanes<VecSSE41>(xs, tweaks);
+}
+
+#endif
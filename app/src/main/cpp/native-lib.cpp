@@ -4,209 +4,300 @@
 #include <vector>
 #include <atomic>
 #include <mutex>
-#include <fstream>
-#include <openssl/sha.h>
-#include <openssl/ripemd.h>
 #include <android/log.h>
 #include <chrono>
 #include <algorithm>
+#include <memory>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include "gen_table.h"
+#include "range_scheduler.h"
+#include "result_sink.h"
+#include "search_session.h"
+#include "secp256k1.h"
+#include "target_decode.h"
 
 #define LOG_TAG "KeySearch"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 
-std::atomic<bool> g_found(false);
-std::atomic<bool> g_pause(false);
-std::mutex file_mutex;
-
-const char* BASE58_ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
-
-// Base58 encode helper
-std::string base58_encode(const std::vector<unsigned char>& input) {
-    std::vector<unsigned char> b(input.begin(), input.end());
-    int zeroes = 0;
-    while (zeroes < (int)b.size() && b[zeroes] == 0) zeroes++;
-
-    std::string result;
-    if (b.empty()) return result;
-
-    std::vector<unsigned char> temp;
-    while (!b.empty()) {
-        int carry = 0;
-        temp.clear();
-        for (size_t i = 0; i < b.size(); ++i) {
-            int val = (int)b[i] + carry * 256;
-            carry = val / 58;
-            temp.push_back((unsigned char)(val % 58));
-        }
-        result.push_back(BASE58_ALPHABET[carry]);
-
-        std::vector<unsigned char> newb;
-        int rem = 0;
-        for (size_t i = 0; i < b.size(); ++i) {
-            int val = rem * 256 + b[i];
-            int q = val / 58;
-            rem = val % 58;
-            if (!newb.empty() || q != 0) newb.push_back((unsigned char)q);
-        }
-        b.swap(newb);
+// حجم مجموعة المشي: كل مجموعة تشترك في انعكاس حقلي واحد ثم تمر معًا عبر نوى التجزئة.
+// 1024 هو أصغر حجم قريب من القمة في القياس (ec_batch_test)، ويبقى مع مخازنه داخل L2 على الهواتف.
+static const size_t DEFAULT_GROUP_SIZE = 1024;
+
+// عدد الدفعات في قطعة الجدولة: 16 دفعة ≈ 16384 مفتاحًا. النواة الأسرع تأخذ MAX_CHUNK_GRAIN قطع
+// في كل طلب (≈ 65536 مفتاحًا، عشرات الميلي ثانية)، والأبطأ أقل بنسبة سرعتها المقاسة،
+// فيقصر ذيل النهاية على أنوية LITTLE دون أن تكثر طلبات الأنوية السريعة.
+static const size_t DEFAULT_CHUNK_BATCHES = 16;
+static const uint64_t MAX_CHUNK_GRAIN = 4;
+
+// أقصى انتظار لخروج العمال عند الإيقاف: كل عامل يفحص الإيقاف بعد كل دفعة (~1 ms)
+static const std::chrono::milliseconds STOP_TIMEOUT(1000);
+
+// يحفظ المفاتيح المكتشفة في سجل النتائج وينهي خدمة Kotlin بعد البحث. المفتاح الموجود والتقدم يقرؤهما
+// التطبيق من كتلة الحالة، فلا استدعاء لـ JVM أثناء البحث. المرجع العام للـ callback يُحذف مرة واحدة
+// حين تنتهي الجلسة من هذا البحث
+class JniSearchListener : public SearchListener {
+public:
+    JniSearchListener(JavaVM* jvm, JNIEnv* env, jobject callback, std::shared_ptr<ResultSink> sink,
+                      std::vector<std::string> addresses, const U256& range_first, const U256& range_last)
+        : jvm_(jvm), callback_(env->NewGlobalRef(callback)), sink_(std::move(sink)),
+          addresses_(std::move(addresses)), range_first_(range_first), range_last_(range_last) {
+        jclass cls = env->GetObjectClass(callback);
+        onSearchFinished_mid_ = env->GetMethodID(cls, "onSearchFinished", "()V");
+        env->DeleteLocalRef(cls);
     }
 
-    std::reverse(result.begin(), result.end());
-    for (int i = 0; i < zeroes; ++i) result.insert(result.begin(), BASE58_ALPHABET[0]);
-    return result;
-}
-
-// حفظ المفاتيح المكتشفة
-void save_result_to_dir(const std::string& dirPath, const std::string& key) {
-    std::lock_guard<std::mutex> lock(file_mutex);
-    std::string full = dirPath;
-    if (!full.empty() && full.back() != '/') full += "/";
-    full += "found_keys.txt";
-    std::ofstream ofs(full, std::ios::app);
-    if (ofs.is_open()) {
-        ofs << key << std::endl;
-        LOGI("Saved key to %s: %s", full.c_str(), key.c_str());
-    } else {
-        LOGI("Failed to open file for writing: %s", full.c_str());
+    ~JniSearchListener() override {
+        JNIEnv* env = current_env();
+        if (env != nullptr) env->DeleteGlobalRef(callback_);
     }
-}
-
-struct ThreadParams {
-    JavaVM* jvm;
-    jobject callbackGlobal;
-    uint64_t start;
-    uint64_t end;
-    std::string target_address;
-};
 
-// البحث في نطاق
-void search_range_thread(ThreadParams* params) {
-    JavaVM* jvm = params->jvm;
-    jobject callback = params->callbackGlobal;
-    uint64_t start = params->start;
-    uint64_t end = params->end;
-    std::string target_address = params->target_address;
-
-    JNIEnv* env = nullptr;
-    if (jvm->AttachCurrentThread(&env, nullptr) != JNI_OK) {
-        delete params;
-        return;
+    void on_key_found(const U256& key, const char* format, size_t target) override {
+        const char* address = target < addresses_.size() ? addresses_[target].c_str() : "";
+        char hex[65];
+        u256_to_hex(key, hex);
+        LOGI("Key found for %s (%s pubkey): %s", address, format, hex);
+        if (!sink_) return;
+        FoundKey found;
+        memset(&found, 0, sizeof(found));
+        found.scalar = key;
+        snprintf(found.address, sizeof(found.address), "%s", address);
+        snprintf(found.format, sizeof(found.format), "%s", format);
+        found.range_first = range_first_;
+        found.range_last = range_last_;
+        found.timestamp = (int64_t)time(nullptr);
+        // الطابور يمتلئ فقط إن توقف الكاتب عن التقدم؛ لا نسقط مفتاحًا، ولا ننتظر القرص مباشرة
+        while (!sink_->push(found)) std::this_thread::yield();
     }
 
-    jclass cls = env->GetObjectClass(callback);
-
-    jmethodID onKeyFound_mid = env->GetMethodID(cls, "onKeyFound", "(Ljava/lang/String;)V");
-    jmethodID onProgressUpdate_mid = env->GetMethodID(cls, "onProgressUpdate", "(J)V");
-    jmethodID onSearchFinished_mid = env->GetMethodID(cls, "onSearchFinished", "()V");
-
-    uint64_t keys_checked = 0;
-    auto last_update = std::chrono::steady_clock::now();
-
-    for (uint64_t k = start; k <= end && !g_found.load(); k++) {
-        while (g_pause.load()) std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-        unsigned char privkey[32] = {0};
-        for (int i = 24; i < 32; ++i) privkey[i] = (k >> ((31 - i) * 8)) & 0xFF;
-
-        unsigned char pubhash[SHA256_DIGEST_LENGTH];
-        SHA256(privkey, 32, pubhash);
-        unsigned char ripemd[RIPEMD160_DIGEST_LENGTH];
-        RIPEMD160(pubhash, SHA256_DIGEST_LENGTH, ripemd);
-
-        std::vector<unsigned char> addr_bytes(1 + RIPEMD160_DIGEST_LENGTH + 4);
-        addr_bytes[0] = 0x00;
-        memcpy(&addr_bytes[1], ripemd, RIPEMD160_DIGEST_LENGTH);
-
-        unsigned char checksum_full[SHA256_DIGEST_LENGTH];
-        SHA256(addr_bytes.data(), RIPEMD160_DIGEST_LENGTH + 1, checksum_full);
-        SHA256(checksum_full, SHA256_DIGEST_LENGTH, checksum_full);
-
-        memcpy(&addr_bytes[RIPEMD160_DIGEST_LENGTH + 1], checksum_full, 4);
-        std::string current_address = base58_encode(addr_bytes);
-
-        keys_checked++;
+    void on_finished() override {
+        // قبل أن تنهي الخدمة نفسها ويصبح قتل العملية واردًا
+        if (sink_) sink_->flush();
+        JNIEnv* env = current_env();
+        if (env != nullptr && onSearchFinished_mid_ != nullptr) env->CallVoidMethod(callback_, onSearchFinished_mid_);
+    }
 
-        if (keys_checked % 50000 == 0 || std::chrono::steady_clock::now() - last_update > std::chrono::seconds(1)) {
-            if (onProgressUpdate_mid != nullptr) env->CallVoidMethod(callback, onProgressUpdate_mid, (jlong)keys_checked);
-            last_update = std::chrono::steady_clock::now();
-        }
+private:
+    JNIEnv* current_env() const {
+        JNIEnv* env = nullptr;
+        if (jvm_->GetEnv((void**)&env, JNI_VERSION_1_6) != JNI_OK) return nullptr;
+        return env;
+    }
 
-        if (current_address == target_address) {
-            g_found.store(true);
+    JavaVM* jvm_;
+    jobject callback_;
+    jmethodID onSearchFinished_mid_;
+    std::shared_ptr<ResultSink> sink_;
+    std::vector<std::string> addresses_;    // بأرقام الأهداف في TargetSet
+    U256 range_first_;
+    U256 range_last_;
+};
 
-            std::string foundStr = std::to_string(k);
-            if (onKeyFound_mid != nullptr) {
-                jstring jkey = env->NewStringUTF(foundStr.c_str());
-                env->CallVoidMethod(callback, onKeyFound_mid, jkey);
-                env->DeleteLocalRef(jkey);
-            }
-            break;
-        }
+// جلسة واحدة طوال عمر العملية: الخيوط تُنشأ وتُربط بـ JVM عند أول بحث فقط
+static std::mutex g_session_mutex;
+static std::unique_ptr<SearchSession> g_session;
+
+static SearchSession* search_session(JavaVM* jvm) {
+    std::lock_guard<std::mutex> lock(g_session_mutex);
+    if (!g_session && jvm != nullptr) {
+        // عامل مثبت لكل نواة متصلة: الأنوية الفيزيائية الأسرع أولًا ثم أشقاء SMT
+        CpuTopology topology = cpu_topology_detect();
+        size_t performance = 0;
+        for (const CpuCore& core : topology.cores) performance += topology.is_performance(core) ? 1 : 0;
+        LOGI("CPU topology: %zu cores, %zu performance%s", topology.cores.size(), performance,
+             topology.heterogeneous() ? " (heterogeneous)" : "");
+        g_session.reset(new SearchSession(
+            topology,
+            [jvm] {
+                JNIEnv* env = nullptr;
+                jvm->AttachCurrentThread(&env, nullptr);
+            },
+            [jvm] { jvm->DetachCurrentThread(); }));
     }
+    return g_session.get();
+}
 
-    if (onSearchFinished_mid != nullptr) env->CallVoidMethod(callback, onSearchFinished_mid);
+static std::string jstring_to_std(JNIEnv* env, jstring str) {
+    if (str == nullptr) return std::string();
+    const char* chars = env->GetStringUTFChars(str, 0);
+    std::string out(chars ? chars : "");
+    env->ReleaseStringUTFChars(str, chars);
+    return out;
+}
 
-    env->DeleteGlobalRef(callback);
-    jvm->DetachCurrentThread();
+// حد النطاق من Kotlin: حتى 64 خانة ست عشرية، مع 0x أو دونها
+static bool parse_range_bound(JNIEnv* env, jstring str, U256& out) {
+    std::string hex = jstring_to_std(env, str);
+    if (hex.size() > 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) hex.erase(0, 2);
+    return u256_from_hex(hex.data(), hex.size(), out);
+}
 
-    delete params;
+// ينهي الطلب دون بحث، فتنهي الخدمة نفسها كما بعد أي بحث
+static void finish_without_search(JNIEnv* env, jobject callback) {
+    jclass cls = env->GetObjectClass(callback);
+    jmethodID onSearchFinished_mid = env->GetMethodID(cls, "onSearchFinished", "()V");
+    if (onSearchFinished_mid != nullptr) env->CallVoidMethod(callback, onSearchFinished_mid);
+    env->DeleteLocalRef(cls);
 }
 
-// الدالة الجديدة للبحث عبر الخدمة
+// الدالة الجديدة للبحث عبر الخدمة. تُستدعى من خيط التحكم في SearchService لا من الخيط الرئيسي:
+// إيقاف البحث السابق وربط الجدول وفتح السجل ونقطة الاستئناف قد تستغرق ثانية أو أكثر
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_example_keysearchapp_SearchService_startSearchNative(JNIEnv *env, jobject thiz,
-                                                             jlong start, jlong end,
-                                                             jstring targetAddr,
+                                                             jstring startHex, jstring endHex,
+                                                             jobjectArray targetAddrs,
+                                                             jstring dataDirStr,
+                                                             jint pubkeyMode,
+                                                             jboolean performanceCoresOnly,
+                                                             jboolean randomOrder,
+                                                             jint progressIntervalMs,
                                                              jobject callback) {
-    const char* target = env->GetStringUTFChars(targetAddr, 0);
-    g_found.store(false);
-    g_pause.store(false);
+    // الأهداف ثابتة طوال البحث، نفكها مرة واحدة هنا بدل ترميز كل مفتاح إلى Base58.
+    // العنوان غير الصالح يُتجاهل، ولا بحث إن لم يبق أي هدف
+    std::vector<std::string> addresses;
+    std::vector<TargetSpec> specs;
+    const jsize target_count = targetAddrs != nullptr ? env->GetArrayLength(targetAddrs) : 0;
+    for (jsize i = 0; i < target_count; ++i) {
+        jstring item = (jstring)env->GetObjectArrayElement(targetAddrs, i);
+        std::string address = jstring_to_std(env, item);
+        env->DeleteLocalRef(item);
+        TargetSpec spec;
+        if (!decode_target(address, spec)) {
+            LOGI("Invalid or unsupported target address: %s", address.c_str());
+            continue;
+        }
+        addresses.push_back(address);
+        specs.push_back(spec);
+    }
+    if (addresses.empty()) {
+        finish_without_search(env, callback);
+        return;
+    }
+    auto targets = std::make_shared<const TargetSet>(specs.data(), specs.size());
+    LOGI("Searching for %zu targets", targets->size());
+
+    // المفاتيح الخاصة الصالحة أقل من رتبة المنحنى n
+    U256 start, end;
+    if (!parse_range_bound(env, startHex, start) || !parse_range_bound(env, endHex, end) ||
+        u256_cmp(start, end) > 0 || u256_cmp(end, SECP256K1_N) >= 0) {
+        LOGI("Invalid key range: %s - %s", jstring_to_std(env, startHex).c_str(), jstring_to_std(env, endHex).c_str());
+        finish_without_search(env, callback);
+        return;
+    }
 
     JavaVM* jvm = nullptr;
     if (env->GetJavaVM(&jvm) != JNI_OK) {
-        env->ReleaseStringUTFChars(targetAddr, target);
+        finish_without_search(env, callback);
         return;
     }
 
-    jobject callbackGlobal = env->NewGlobalRef(callback);
-
-    int numThreads = std::thread::hardware_concurrency();
-    uint64_t totalKeys = end - start + 1;
-    uint64_t keysPerThread = totalKeys / numThreads;
+    SearchSession* session = search_session(jvm);
+
+    // جدول مضاعفات G: يُربط من الملف إن وُجد، ويُبنى مرة واحدة فقط عند غيابه أو تلفه
+    std::string dataDir = jstring_to_std(env, dataDirStr);
+
+    // عمال البحث السابق يكتبون في نقطة استئنافه، وقد تكون نفس ملف هذا البحث
+    if (!session->stop(STOP_TIMEOUT)) LOGI("Search workers still running after stop timeout");
+
+    SearchJob job;
+    job.table = GeneratorTable::open_or_build(dataDir);
+    // قطع صغيرة بدل شريحة ثابتة لكل خيط: الخيط الذي ينهي شريحته يسرق من المتأخر،
+    // والحصص الأولى بنسبة سرعة كل نواة المقاسة في البحث السابق.
+    // النطاقات الهائلة تُقسم إلى قطع أكبر حتى يبقى bitmap نقطة الاستئناف ضمن حده
+    const U256 chunk_keys = range_chunk_keys(start, end, DEFAULT_GROUP_SIZE * DEFAULT_CHUNK_BATCHES,
+                                             DEFAULT_GROUP_SIZE, CHECKPOINT_MAX_CHUNKS);
+    U256 span, chunks, rem;
+    u256_sub(span, end, start);
+    u256_divmod(span, chunk_keys, chunks, rem);
+    // الترتيب العشوائي بمفتاح جديد لكل بحث؛ نقطة الاستئناف بأرقام القطع لا بمواضعها، فتصلح لأي ترتيب
+    const uint64_t chunk_count = chunks.d[0] + 1;
+    ChunkOrder order;
+    if (randomOrder == JNI_TRUE && chunk_count > 1) {
+        std::random_device rd;
+        order = ChunkOrder(chunk_count, ((uint64_t)rd() << 32) ^ rd());
+    }
+    job.scheduler = std::make_shared<RangeScheduler>(start, end, chunk_keys,
+                                                     session->worker_weights(performanceCoresOnly == JNI_TRUE),
+                                                     MAX_CHUNK_GRAIN, order);
+    job.targets = targets;
+    job.pubkey_mode = (pubkeyMode >= 0 && pubkeyMode <= 2) ? (PubkeyMode)pubkeyMode : PubkeyMode::Compressed;
+
+    // نفس النطاق والهدف والصيغة بعد إعادة تشغيل الخدمة يكمل من حيث توقف
+    CheckpointIdentity identity;
+    memset(&identity, 0, sizeof(identity));
+    identity.start = start;
+    identity.end = end;
+    identity.chunk_keys = chunk_keys;
+    identity.chunk_count = job.scheduler->chunk_count();
+    targets->fingerprint(identity.targets);
+    identity.pubkey_mode = (uint32_t)job.pubkey_mode;
+    job.checkpoint = SearchCheckpoint::open(dataDir, identity);
+    job.group_size = DEFAULT_GROUP_SIZE;
+    job.progress_interval = std::chrono::milliseconds(progressIntervalMs > 0 ? progressIntervalMs : 1000);
+    // السجل يُفتح مرة لكل عملية، وفتحه يعيد قراءة ما حُفظ في المرات السابقة
+    job.listener = std::make_shared<JniSearchListener>(jvm, env, callback, ResultSink::open(dataDir),
+                                                       std::move(addresses), start, end);
+
+    // يوقف أي بحث سابق وينتظر عماله قبل أن يبدأ هذا
+    if (!session->start(job, STOP_TIMEOUT)) {
+        LOGI("Previous search did not stop in time, new search not started");
+        job.listener->on_finished();
+    }
+}
 
-    for (int i = 0; i < numThreads; i++) {
-        uint64_t threadStart = start + i * keysPerThread;
-        uint64_t threadEnd = (i == numThreads - 1) ? end : (threadStart + keysPerThread - 1);
+// كتلة الحالة كـ ByteBuffer مباشر على ذاكرة الجلسة: تُطلب مرة واحدة ويقرؤها التطبيق كل إطار دون أي استدعاء
+extern "C"
+JNIEXPORT jobject JNICALL
+Java_com_example_keysearchapp_NativeLoader_statusBuffer(JNIEnv *env, jobject thiz) {
+    JavaVM* jvm = nullptr;
+    if (env->GetJavaVM(&jvm) != JNI_OK) return nullptr;
+    SearchSession* session = search_session(jvm);
+    return env->NewDirectByteBuffer(session->status().data(), (jlong)StatusBlock::size());
+}
 
-        ThreadParams* params = new ThreadParams();
-        params->jvm = jvm;
-        params->callbackGlobal = callbackGlobal;
-        params->start = threadStart;
-        params->end = threadEnd;
-        params->target_address = std::string(target ? target : "");
+// حاجز acquire لقراءة seqlock من Kotlin قبل API 33 (لا VarHandle.acquireFence هناك)
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_example_keysearchapp_NativeLoader_acquireFence(JNIEnv *env, jobject thiz) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+}
 
-        std::thread t(search_range_thread, params);
-        t.detach();
+// المفاتيح المحفوظة في dataDir/found_keys.log من هذه العملية والعمليات السابقة، سطر لكل مفتاح
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_example_keysearchapp_NativeLoader_foundKeys(JNIEnv *env, jobject thiz, jstring dataDirStr) {
+    std::shared_ptr<ResultSink> sink = ResultSink::open(jstring_to_std(env, dataDirStr));
+    std::vector<FoundKey> records;
+    if (sink) records = sink->records();
+
+    jclass string_cls = env->FindClass("java/lang/String");
+    jobjectArray out = env->NewObjectArray((jsize)records.size(), string_cls, nullptr);
+    for (size_t i = 0; out != nullptr && i < records.size(); ++i) {
+        jstring line = env->NewStringUTF(found_key_to_string(records[i]).c_str());
+        env->SetObjectArrayElement(out, (jsize)i, line);
+        env->DeleteLocalRef(line);
     }
-
-    env->ReleaseStringUTFChars(targetAddr, target);
+    env->DeleteLocalRef(string_cls);
+    return out;
 }
 
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_example_keysearchapp_SearchService_pauseSearchNative(JNIEnv *env, jobject thiz) {
-    g_pause.store(true);
+    if (SearchSession* session = search_session(nullptr)) session->pause();
 }
 
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_example_keysearchapp_SearchService_resumeSearchNative(JNIEnv *env, jobject thiz) {
-    g_pause.store(false);
+    if (SearchSession* session = search_session(nullptr)) session->resume();
 }
 
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_example_keysearchapp_SearchService_stopSearchNative(JNIEnv *env, jobject thiz) {
-    g_found.store(true);
+    SearchSession* session = search_session(nullptr);
+    if (session != nullptr && !session->stop(STOP_TIMEOUT)) LOGI("Search workers still running after stop timeout");
 }
\ No newline at end of file
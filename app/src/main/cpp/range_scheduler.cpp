@@ -0,0 +1,152 @@
+#include "range_scheduler.h"
+
+U256 range_chunk_keys(const U256& start, const U256& end, uint64_t chunk_keys, uint64_t group, uint64_t max_chunks) {
+    U256 span, chunks, rem;
+    u256_sub(span, end, start);
+    u256_divmod(span, u256_from_u64(chunk_keys), chunks, rem);
+    if (u256_fits_u64(chunks) && chunks.d[0] < max_chunks) return u256_from_u64(chunk_keys);
+    // (span / (max_chunks * group) + 1) * group > span / max_chunks، فيقل عدد القطع عن max_chunks
+    U256 groups;
+    u256_divmod(span, u256_from_u64(max_chunks * group), groups, rem);
+    u256_add_u64(groups, groups, 1);
+    U256 keys;
+    u256_mul_u64(keys, groups, group);
+    return keys;
+}
+
+RangeScheduler::RangeScheduler(const U256& start, const U256& end, const U256& chunk_keys, size_t workers)
+    : RangeScheduler(start, end, chunk_keys, std::vector<double>(workers ? workers : 1, 1.0), 1) {}
+
+RangeScheduler::RangeScheduler(const U256& start, const U256& end, const U256& chunk_keys,
+                               const std::vector<double>& weights, uint64_t max_grain, const ChunkOrder& order)
+    : start_(start), end_(end), chunk_keys_(chunk_keys), workers_(weights.empty() ? 1 : weights.size()),
+      order_(order), queues_(new WorkerQueue[weights.empty() ? 1 : weights.size()]) {
+    init(weights.empty() ? std::vector<double>(1, 1.0) : weights, max_grain ? max_grain : 1);
+}
+
+void RangeScheduler::init(const std::vector<double>& weights, uint64_t max_grain) {
+    // (end - start) / chunk_keys + 1 بدل (end - start + 1) لتفادي الفيضان عند النطاق الكامل
+    chunk_count_ = 0;
+    range_keys_ = 0;
+    if (u256_cmp(start_, end_) <= 0) {
+        U256 span, quotient, rem;
+        u256_sub(span, end_, start_);
+        u256_divmod(span, chunk_keys_, quotient, rem);
+        chunk_count_ = quotient.d[0] + 1;
+        range_keys_ = u256_to_double(span) + 1.0;
+    }
+
+    double total = 0, fastest = 0;
+    for (double w : weights) {
+        total += w > 0 ? w : 0;
+        fastest = w > fastest ? w : fastest;
+    }
+
+    // شرائح متصلة بحجم يتناسب مع الوزن، فيبقى كل خيط يمشي مفاتيح متتالية ما لم يسرق.
+    // آخر خيط بوزن موجب يأخذ الباقي فلا تضيع قطعة بسبب التقريب
+    size_t last = 0;
+    for (size_t i = 0; i < workers_; ++i) {
+        if (weights[i] > 0) last = i;
+    }
+    uint64_t next = 0;
+    double acc = 0;
+    for (size_t i = 0; i < workers_; ++i) {
+        WorkerQueue& q = queues_[i];
+        uint64_t len = 0;
+        if (total > 0 && weights[i] > 0) {
+            acc += weights[i];
+            uint64_t boundary = i == last ? chunk_count_ : (uint64_t)((long double)chunk_count_ * acc / total);
+            len = boundary > next ? boundary - next : 0;
+            q.grain = (uint64_t)(max_grain * weights[i] / fastest + 0.5);
+            if (q.grain == 0) q.grain = 1;
+        } else if (total <= 0 && i == 0) {
+            // لا أوزان صالحة: خيط واحد يأخذ النطاق كله
+            len = chunk_count_;
+            q.grain = 1;
+        }
+        q.next.store(next, std::memory_order_relaxed);
+        q.end.store(next + len, std::memory_order_relaxed);
+        next += len;
+    }
+}
+
+uint64_t RangeScheduler::chunk_index(const U256& key) const {
+    U256 offset, index, rem;
+    u256_sub(offset, key, start_);
+    u256_divmod(offset, chunk_keys_, index, rem);
+    return index.d[0];
+}
+
+KeyChunk RangeScheduler::chunk(uint64_t index) const {
+    KeyChunk chunk;
+    U256 offset;
+    u256_mul_u64(offset, chunk_keys_, index);
+    u256_add(chunk.first, start_, offset);
+    if (index + 1 == chunk_count_) {
+        chunk.last = end_;
+    } else {
+        u256_add(chunk.last, chunk.first, chunk_keys_);
+        u256_sub(chunk.last, chunk.last, u256_from_u64(1));
+    }
+    return chunk;
+}
+
+bool RangeScheduler::take_own(size_t worker, ChunkSpan& span) {
+    WorkerQueue& own = queues_[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    uint64_t next = own.next.load(std::memory_order_relaxed);
+    uint64_t end = own.end.load(std::memory_order_relaxed);
+    if (next >= end) return false;
+    uint64_t count = end - next < own.grain ? end - next : own.grain;
+    own.next.store(next + count, std::memory_order_relaxed);
+    span.first = next;
+    span.count = count;
+    return true;
+}
+
+bool RangeScheduler::next_span(size_t worker, ChunkSpan& span) {
+    if (queues_[worker].grain == 0) return false;
+    if (take_own(worker, span)) return true;
+    // السرقة تنقل نصف شريحة الضحية إلى شريحة السارق، ثم يأخذ منها كالمعتاد
+    while (steal(worker)) {
+        if (take_own(worker, span)) return true;
+    }
+    return false;
+}
+
+bool RangeScheduler::steal(size_t thief) {
+    for (;;) {
+        // الضحية: أكثر الخيوط قطعًا متبقية
+        size_t victim = workers_;
+        uint64_t most = 0;
+        for (size_t i = 0; i < workers_; ++i) {
+            if (i == thief) continue;
+            uint64_t next = queues_[i].next.load(std::memory_order_relaxed);
+            uint64_t end = queues_[i].end.load(std::memory_order_relaxed);
+            if (end > next && end - next > most) {
+                most = end - next;
+                victim = i;
+            }
+        }
+        if (victim == workers_) return false;
+
+        uint64_t begin, end;
+        {
+            WorkerQueue& q = queues_[victim];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            uint64_t next = q.next.load(std::memory_order_relaxed);
+            end = q.end.load(std::memory_order_relaxed);
+            if (next >= end) continue;      // سبقنا إليها غيرنا، نعيد الاختيار
+            // النصف الأخير (والقطعة الوحيدة إن بقيت واحدة)، والضحية تكمل من أوله
+            begin = end - (end - next + 1) / 2;
+            q.end.store(begin, std::memory_order_relaxed);
+        }
+
+        // المسروق يصير شريحة السارق الجديدة، قابلة للسرقة بدورها
+        WorkerQueue& own = queues_[thief];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.next.store(begin, std::memory_order_relaxed);
+        own.end.store(end, std::memory_order_relaxed);
+        return true;
+    }
+}
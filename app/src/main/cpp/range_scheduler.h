@@ -0,0 +1,86 @@
+#pragma once
+
+// توزيع نطاق المفاتيح على الخيوط بقطع صغيرة مع سرقة العمل:
+// كل خيط يبدأ بشريحة متصلة من القطع ويأخذ منها بالترتيب، وحين تفرغ شريحته
+// يسرق النصف الأخير مما تبقى عند أكثر الخيوط تأخرًا. هكذا تنتهي النوى البطيئة
+// (LITTLE) مع السريعة بدل أن ينتظر البحث كله أبطأ شريحة ثابتة.
+// الشرائح الأولى وعدد القطع التي يأخذها الخيط كل مرة يتناسبان مع سرعته المقاسة.
+// الشرائح مواضع في ترتيب الزيارة (ChunkOrder)، و chunk_at يحول الموضع إلى رقم القطعة.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "chunk_order.h"
+#include "uint256.h"
+
+// قطعة مفاتيح متصلة [first, last] (شاملة)
+struct KeyChunk {
+    U256 first;
+    U256 last;
+};
+
+// مواضع متتالية [first, first + count) في ترتيب الزيارة
+struct ChunkSpan {
+    uint64_t first;
+    uint64_t count;
+};
+
+// طول القطعة لنطاق [start, end]: chunk_keys عادةً، وفي النطاقات الهائلة أصغر مضاعف لـ group يبقي عدد القطع
+// ((end - start) / الطول + 1) دون max_chunks. chunk_keys مضاعف لـ group، و max_chunks * group يتسع في 64 بت
+U256 range_chunk_keys(const U256& start, const U256& end, uint64_t chunk_keys, uint64_t group, uint64_t max_chunks);
+
+class RangeScheduler {
+public:
+    // النطاق [start, end] شامل، و chunk_keys > 0 (يُفضّل مضاعفًا لحجم الدفعة).
+    // عدد القطع (end - start) / chunk_keys + 1 يجب أن يتسع في 64 بت: النطاقات الهائلة تُعطى قطعًا أكبر
+    RangeScheduler(const U256& start, const U256& end, const U256& chunk_keys, size_t workers);
+
+    // weights[i] سرعة الخيط i النسبية (مفاتيح/ث). الخيط ذو الوزن 0 لا يشارك (ولا يسرق).
+    // الأسرع يأخذ max_grain قطعة في كل طلب، والأبطأ أقل بالتناسب (قطعة واحدة على الأقل).
+    // order يحدد ترتيب زيارة القطع، والافتراضي خطي
+    RangeScheduler(const U256& start, const U256& end, const U256& chunk_keys, const std::vector<double>& weights,
+                   uint64_t max_grain, const ChunkOrder& order = ChunkOrder());
+
+    // المواضع التالية للخيط worker (حتى grain موضعًا): من شريحته أولًا ثم بالسرقة.
+    // يعيد false حين ينفد النطاق كله.
+    bool next_span(size_t worker, ChunkSpan& span);
+
+    // رقم القطعة في الموضع position. في الترتيب الخطي المواضع المتتالية قطع متجاورة
+    uint64_t chunk_at(uint64_t position) const { return order_.at(position); }
+
+    uint64_t chunk_count() const { return chunk_count_; }
+    const U256& chunk_keys() const { return chunk_keys_; }
+    // رقم القطعة التي تحوي key، وحدود القطعة index (الأخيرة قد تكون أقصر)
+    uint64_t chunk_index(const U256& key) const;
+    KeyChunk chunk(uint64_t index) const;
+    // عدد مفاتيح النطاق كله تقريبيًا، للتغطية فقط
+    double range_keys() const { return range_keys_; }
+    size_t workers() const { return workers_; }
+
+private:
+    // قطع [next, end) لم يأخذها أحد بعد. التعديل تحت mutex، والقراءة الذرية
+    // دون قفل تكفي لاختيار الضحية الأكثر تأخرًا
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::atomic<uint64_t> next{0};
+        std::atomic<uint64_t> end{0};
+        uint64_t grain = 0;         // 0: الخيط لا يشارك في هذا البحث
+    };
+
+    void init(const std::vector<double>& weights, uint64_t max_grain);
+    bool take_own(size_t worker, ChunkSpan& span);
+    bool steal(size_t thief);
+
+    U256 start_;
+    U256 end_;
+    U256 chunk_keys_;
+    uint64_t chunk_count_;
+    double range_keys_;
+    size_t workers_;
+    ChunkOrder order_;
+    std::unique_ptr<WorkerQueue[]> queues_;
+};
@@ -0,0 +1,289 @@
+#include "result_sink.h"
+
+#include <android/log.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+#define LOG_TAG "KeySearch"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+
+static const char RESULT_MAGIC[4] = {'K', 'S', 'F', 'K'};
+
+// خانة السجل: ترويسة 16 بايت ثم النص. 512 بايت تكفي لثلاثة أعداد بـ 64 خانة وهدف بـ 131 وصيغة
+static const size_t RESULT_SLOT_SIZE = 512;
+static const size_t RESULT_HEADER_SIZE = 16;
+static const size_t RESULT_TEXT_MAX = RESULT_SLOT_SIZE - RESULT_HEADER_SIZE;
+static_assert(3 * 64 + sizeof(FoundKey::address) + sizeof(FoundKey::format) + 32 < RESULT_TEXT_MAX, "record text fits a slot");
+// يُحجز الملف بهذا العدد من الخانات كل مرة، فلا تغيّر الإضافة حجمه ولا بياناته الوصفية عادة
+static const size_t RESULT_PREALLOC_SLOTS = 64;
+
+// أقصى تأخر لاستيقاظ الكاتب إن فاته إشعار (العامل يشعره دون قفل)
+static const std::chrono::milliseconds WRITER_POLL(50);
+
+struct SlotHeader {
+    char magic[4];
+    uint32_t length;
+    uint32_t crc32;
+    uint32_t reserved;
+};
+static_assert(sizeof(SlotHeader) == RESULT_HEADER_SIZE, "slot header layout");
+
+static uint32_t text_crc(const char* text, uint32_t length) {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(&length), sizeof(length));
+    return (uint32_t)crc32(crc, reinterpret_cast<const Bytef*>(text), length);
+}
+
+std::string found_key_to_string(const FoundKey& key) {
+    char scalar[65], first[65], last[65];
+    u256_to_hex(key.scalar, scalar);
+    u256_to_hex(key.range_first, first);
+    u256_to_hex(key.range_last, last);
+    char buf[RESULT_TEXT_MAX];
+    snprintf(buf, sizeof(buf), "%s %s %s %s-%s %lld", scalar, key.address[0] ? key.address : "-",
+             key.format[0] ? key.format : "-", first, last, (long long)key.timestamp);
+    return buf;
+}
+
+static bool parse_found_key(const char* text, FoundKey& key) {
+    char scalar[65], first[65], last[65];
+    long long timestamp;
+    memset(&key, 0, sizeof(key));
+    if (sscanf(text, "%64s %131s %15s %64[0-9a-f]-%64s %lld", scalar, key.address, key.format, first, last,
+               &timestamp) != 6)
+        return false;
+    key.timestamp = timestamp;
+    if (strcmp(key.address, "-") == 0) key.address[0] = 0;
+    if (strcmp(key.format, "-") == 0) key.format[0] = 0;
+    return strlen(scalar) == 64 && u256_from_hex(scalar, 64, key.scalar) && strlen(first) == 64 &&
+           u256_from_hex(first, 64, key.range_first) && strlen(last) == 64 && u256_from_hex(last, 64, key.range_last);
+}
+
+static void encode_slot(const FoundKey& key, unsigned char slot[RESULT_SLOT_SIZE]) {
+    memset(slot, 0, RESULT_SLOT_SIZE);
+    std::string text = found_key_to_string(key);
+    SlotHeader h;
+    memcpy(h.magic, RESULT_MAGIC, sizeof(h.magic));
+    h.length = (uint32_t)text.size();
+    h.crc32 = text_crc(text.data(), h.length);
+    h.reserved = 0;
+    memcpy(slot, &h, sizeof(h));
+    memcpy(slot + RESULT_HEADER_SIZE, text.data(), text.size());
+}
+
+static bool decode_slot(const unsigned char slot[RESULT_SLOT_SIZE], FoundKey& key) {
+    SlotHeader h;
+    memcpy(&h, slot, sizeof(h));
+    if (memcmp(h.magic, RESULT_MAGIC, sizeof(h.magic)) != 0 || h.length >= RESULT_TEXT_MAX) return false;
+    char text[RESULT_TEXT_MAX];
+    memcpy(text, slot + RESULT_HEADER_SIZE, h.length);
+    text[h.length] = 0;
+    return text_crc(text, h.length) == h.crc32 && parse_found_key(text, key);
+}
+
+static bool same_key(const FoundKey& a, const FoundKey& b) {
+    return u256_cmp(a.scalar, b.scalar) == 0 && strcmp(a.address, b.address) == 0;
+}
+
+static bool contains_key(const std::vector<FoundKey>& keys, const FoundKey& key) {
+    for (const FoundKey& k : keys) {
+        if (same_key(k, key)) return true;
+    }
+    return false;
+}
+
+static bool write_all(int fd, const unsigned char* p, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t n = pwrite(fd, p, size, offset);
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+        offset += n;
+    }
+    return true;
+}
+
+// يحجز مساحة RESULT_PREALLOC_SLOTS خانة بعد size. فشل الحجز ليس خطأ: pwrite يمد الملف بنفسه
+static uint64_t preallocate(int fd, uint64_t size) {
+    uint64_t grown = size + RESULT_PREALLOC_SLOTS * RESULT_SLOT_SIZE;
+    if (posix_fallocate(fd, (off_t)size, (off_t)(grown - size)) != 0) return size;
+    return grown;
+}
+
+ResultSink::ResultSink() {
+    for (size_t i = 0; i < HIT_QUEUE_SIZE; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+ResultSink::~ResultSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    writer_cv_.notify_all();
+    if (writer_.joinable()) writer_.join();
+    if (fd_ >= 0) close(fd_);
+}
+
+// يقرأ الخانات حتى أول خانة لم تُكتب قط. إن وُجدت خانة تالفة أو مكررة يُعاد كتابة الملف
+// مضغوطًا (ملف مؤقت ثم rename) حتى لا تتراكم، وإلا فالإضافة تستأنف بعد آخر خانة
+bool ResultSink::replay(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd_ < 0) return false;
+    struct stat st;
+    if (fstat(fd_, &st) != 0) return false;
+    file_size_ = (uint64_t)st.st_size;
+
+    std::vector<unsigned char> data(file_size_);
+    size_t have = 0;
+    while (have < data.size()) {
+        ssize_t n = pread(fd_, data.data() + have, data.size() - have, (off_t)have);
+        if (n <= 0) break;
+        have += (size_t)n;
+    }
+
+    size_t dropped = 0;
+    size_t slots = 0;
+    static const char EMPTY_MAGIC[4] = {0, 0, 0, 0};
+    for (; (slots + 1) * RESULT_SLOT_SIZE <= have; ++slots) {
+        const unsigned char* slot = data.data() + slots * RESULT_SLOT_SIZE;
+        if (memcmp(slot, EMPTY_MAGIC, sizeof(EMPTY_MAGIC)) == 0) break;
+        FoundKey key;
+        if (!decode_slot(slot, key) || contains_key(records_, key)) ++dropped;
+        else records_.push_back(key);
+    }
+    append_offset_ = slots * RESULT_SLOT_SIZE;
+
+    if (dropped > 0) {
+        std::string tmp = path + ".tmp";
+        int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd < 0) return false;
+        std::vector<unsigned char> out(records_.size() * RESULT_SLOT_SIZE);
+        for (size_t i = 0; i < records_.size(); ++i) encode_slot(records_[i], out.data() + i * RESULT_SLOT_SIZE);
+        bool ok = write_all(fd, out.data(), out.size(), 0) && fsync(fd) == 0;
+        if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+            close(fd);
+            unlink(tmp.c_str());
+            return false;
+        }
+        close(fd_);
+        fd_ = fd;
+        file_size_ = out.size();
+        append_offset_ = out.size();
+    }
+
+    if (file_size_ < append_offset_ + RESULT_SLOT_SIZE) file_size_ = preallocate(fd_, file_size_);
+    LOGI("Result log %s: %zu keys replayed, %zu damaged or duplicate records dropped", path.c_str(),
+         records_.size(), dropped);
+    return true;
+}
+
+std::shared_ptr<ResultSink> ResultSink::open(const std::string& dir) {
+    static std::mutex cache_mutex;
+    // الكاتب وخانة الإضافة لكل ملف يجب أن تكون واحدة داخل العملية
+    static std::map<std::string, std::shared_ptr<ResultSink>> cache;
+    if (dir.empty()) return nullptr;
+
+    std::string path = dir;
+    if (path.back() != '/') path += "/";
+    path += "found_keys.log";
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(path);
+    if (it != cache.end()) return it->second;
+
+    std::shared_ptr<ResultSink> sink(new ResultSink());
+    if (!sink->replay(path)) {
+        LOGI("Result log: cannot open %s", path.c_str());
+        return nullptr;
+    }
+    sink->writer_ = std::thread(&ResultSink::writer_main, sink.get());
+    cache[path] = sink;
+    return sink;
+}
+
+bool ResultSink::push(const FoundKey& key) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos % HIT_QUEUE_SIZE];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+    cell->value = key;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    writer_cv_.notify_one();
+    return true;
+}
+
+bool ResultSink::pop(FoundKey& key) {
+    Cell& cell = cells_[tail_ % HIT_QUEUE_SIZE];
+    if (cell.sequence.load(std::memory_order_acquire) != tail_ + 1) return false;
+    key = cell.value;
+    cell.sequence.store(tail_ + HIT_QUEUE_SIZE, std::memory_order_release);
+    ++tail_;
+    return true;
+}
+
+void ResultSink::flush() {
+    uint64_t target = pushed_.load();
+    writer_cv_.notify_one();
+    std::unique_lock<std::mutex> lock(mutex_);
+    flushed_cv_.wait(lock, [&] { return written_ >= target || shutdown_; });
+}
+
+std::vector<FoundKey> ResultSink::records() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+}
+
+bool ResultSink::write_record(const FoundKey& key) {
+    if (append_offset_ + RESULT_SLOT_SIZE > file_size_)
+        file_size_ = preallocate(fd_, std::max(file_size_, append_offset_));
+    unsigned char slot[RESULT_SLOT_SIZE];
+    encode_slot(key, slot);
+    if (!write_all(fd_, slot, sizeof(slot), (off_t)append_offset_)) return false;
+    append_offset_ += RESULT_SLOT_SIZE;
+    return true;
+}
+
+void ResultSink::writer_main() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        writer_cv_.wait_for(lock, WRITER_POLL, [&] { return shutdown_ || pushed_.load() != written_; });
+        if (shutdown_ && pushed_.load() == written_) break;
+
+        // records_ لا يعدّله غير هذا الخيط، فقراءته دون القفل هنا آمنة
+        lock.unlock();
+        std::vector<FoundKey> saved;
+        uint64_t done = 0;
+        FoundKey key;
+        while (pop(key)) {
+            ++done;
+            if (contains_key(records_, key) || contains_key(saved, key)) continue;
+            if (!write_record(key)) LOGI("Result log: write failed, key kept in memory only");
+            saved.push_back(key);
+        }
+        if (!saved.empty() && fsync(fd_) != 0) LOGI("Result log: fsync failed");
+        lock.lock();
+
+        records_.insert(records_.end(), saved.begin(), saved.end());
+        written_ += done;
+        flushed_cv_.notify_all();
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+// سجل المفاتيح المكتشفة في dir/found_keys.log.
+// العامل يضع النتيجة في طابور حلقي خالٍ من الأقفال ويعود فورًا، وخيط كاتب واحد يلحقها
+// بملف محجوز مسبقًا ثم fsync. كل سجل في خانة ثابتة الحجم محمية بـ CRC-32، فالخانة التي قطعها
+// موت العملية تُتجاهل عند القراءة. عند الفتح تُقرأ السجلات السليمة وتُزال المكررة،
+// فلا يضيع مفتاح وُجد ولو قُتلت الخدمة بعده مباشرة.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "uint256.h"
+
+// نتائج تنتظر الكاتب. الإصابات نادرة جدًا، فالامتلاء يعني أن القرص معطل لا أن الطابور صغير
+static const size_t HIT_QUEUE_SIZE = 64;
+
+struct FoundKey {
+    U256 scalar;
+    char address[132];      // الهدف كما أُدخل (حتى مفتاح عام كامل بـ 130 خانة)، منتهٍ بصفر
+    char format[16];        // صيغة المفتاح العام التي طابقت
+    U256 range_first;       // نطاق البحث الذي وُجد فيه
+    U256 range_last;
+    int64_t timestamp;      // ثواني يونكس
+};
+
+// "scalar address format first-last timestamp" بالست عشري الكامل، وهو نص كل سجل في الملف
+std::string found_key_to_string(const FoundKey& key);
+
+class ResultSink {
+public:
+    ~ResultSink();
+
+    // يفتح dir/found_keys.log (أو ينشئه) ويعيد قراءته. يعيد نفس السجل للمسار نفسه داخل العملية،
+    // و nullptr إن تعذر فتح الملف للكتابة.
+    static std::shared_ptr<ResultSink> open(const std::string& dir);
+
+    // من العمال: لا قفل ولا I/O. يعيد false فقط إن امتلأ الطابور
+    bool push(const FoundKey& key);
+    // ينتظر حتى يُحفظ كل ما دُفع قبل الاستدعاء
+    void flush();
+    // المفاتيح المحفوظة دون تكرار، بترتيب حفظها
+    std::vector<FoundKey> records();
+
+private:
+    // طابور Vyukov محدود لعدة منتجين ومستهلك واحد: كل خانة تحمل رقم الدورة الذي يسمح بالكتابة أو القراءة
+    struct Cell {
+        std::atomic<size_t> sequence;
+        FoundKey value;
+    };
+
+    ResultSink();
+    ResultSink(const ResultSink&) = delete;
+    ResultSink& operator=(const ResultSink&) = delete;
+
+    bool replay(const std::string& path);
+    bool pop(FoundKey& key);
+    bool write_record(const FoundKey& key);
+    void writer_main();
+
+    int fd_ = -1;
+    uint64_t append_offset_ = 0;    // أول خانة فارغة
+    uint64_t file_size_ = 0;        // المحجوز بـ fallocate
+
+    Cell cells_[HIT_QUEUE_SIZE];
+    std::atomic<size_t> head_{0};   // موضع الدفع التالي، للمنتجين
+    size_t tail_ = 0;               // موضع السحب التالي، للكاتب وحده
+    std::atomic<uint64_t> pushed_{0};
+
+    std::mutex mutex_;
+    std::condition_variable writer_cv_;     // الكاتب ينتظر نتائج جديدة أو الإغلاق
+    std::condition_variable flushed_cv_;    // flush ينتظر تقدم written_
+    uint64_t written_ = 0;                  // نتائج انتهى الكاتب منها (حُفظت أو كانت مكررة)
+    bool shutdown_ = false;
+    std::vector<FoundKey> records_;         // تحت mutex_
+    std::thread writer_;
+};
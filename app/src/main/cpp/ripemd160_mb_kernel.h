@@ -0,0 +1,123 @@
+#pragma once
+
+// نواة RIPEMD-160 متعددة المسارات، مخصصة لمدخل بطول 32 بايت (ناتج SHA-256):
+// كتلة واحدة دائمًا، وكلمات الحشو والطول (X[8..15]) ثابتة ومدمجة في ثوابت الجولات.
+// تقرأ حالة SHA-256 من المسارات مباشرة، فالمرحلتان معًا تكوّنان hash160 بلا إعادة ترتيب.
+
+#include <utility>
+
+#include "sha256_fixed.h"
+#include "simd.h"
+
+static constexpr int RMD_R_LEFT[80] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+    3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+    1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+    4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13};
+static constexpr int RMD_R_RIGHT[80] = {
+    5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+    6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+    15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+    8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+    12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11};
+static constexpr int RMD_S_LEFT[80] = {
+    11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+    7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+    11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+    11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+    9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6};
+static constexpr int RMD_S_RIGHT[80] = {
+    8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+    9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+    9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+    15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+    8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11};
+static constexpr uint32_t RMD_K_LEFT[5] = {0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E};
+static constexpr uint32_t RMD_K_RIGHT[5] = {0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000};
+static constexpr uint32_t RMD_IV[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+// كلمات الحشو لرسالة 32 بايت: 0x80 بعد البيانات ثم الطول بالبت (256) في X[14]
+static constexpr uint32_t RMD_PAD32[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0x80, 0, 0, 0, 0, 0, 256, 0};
+
+template <class V, int F>
+static inline V rmd_f(V x, V y, V z) {
+    if (F == 0) return x ^ y ^ z;
+    if (F == 1) return (x & y) | V::andnot(x, z);
+    if (F == 2) return V::ornot(x, y) ^ z;
+    if (F == 3) return (x & z) | V::andnot(z, y);
+    return x ^ V::ornot(y, z);
+}
+
+// خطوة واحدة: X[R] من البيانات فقط عندما R < 8، وإلا فهي ثابت مضموم إلى K
+template <class V, int F, int R, int S>
+static inline void rmd_step(V& a, V& b, V& c, V& d, V& e, const V x[8], uint32_t k) {
+    V t;
+    if (R < 8) {
+        t = a + rmd_f<V, F>(b, c, d) + x[R < 8 ? R : 0] + V::set1(k);
+    } else {
+        t = a + rmd_f<V, F>(b, c, d) + V::set1(k + RMD_PAD32[R]);
+    }
+    t = V::template rotl<S>(t) + e;
+    a = e;
+    e = d;
+    d = V::template rotl<10>(c);
+    c = b;
+    b = t;
+}
+
+template <class V, int J>
+static inline void rmd_left(V& a, V& b, V& c, V& d, V& e, const V x[8]) {
+    rmd_step<V, J / 16, RMD_R_LEFT[J], RMD_S_LEFT[J]>(a, b, c, d, e, x, RMD_K_LEFT[J / 16]);
+}
+
+template <class V, int J>
+static inline void rmd_right(V& a, V& b, V& c, V& d, V& e, const V x[8]) {
+    rmd_step<V, 4 - J / 16, RMD_R_RIGHT[J], RMD_S_RIGHT[J]>(a, b, c, d, e, x, RMD_K_RIGHT[J / 16]);
+}
+
+template <class V, int... J>
+static inline void rmd_rounds(V l[5], V r[5], const V x[8], std::integer_sequence<int, J...>) {
+    (rmd_left<V, J>(l[0], l[1], l[2], l[3], l[4], x), ...);
+    (rmd_right<V, J>(r[0], r[1], r[2], r[3], r[4], x), ...);
+}
+
+// x[8]: كلمات الرسالة الثمانية الأولى (little-endian) لكل المسارات، h[5]: الناتج
+template <class V>
+static inline void ripemd160_mb_32(const V x[8], V h[5]) {
+    V l[5], r[5];
+    for (int i = 0; i < 5; ++i) l[i] = r[i] = V::set1(RMD_IV[i]);
+    rmd_rounds<V>(l, r, x, std::make_integer_sequence<int, 80>());
+
+    h[0] = V::set1(RMD_IV[1]) + l[2] + r[3];
+    h[1] = V::set1(RMD_IV[2]) + l[3] + r[4];
+    h[2] = V::set1(RMD_IV[3]) + l[4] + r[0];
+    h[3] = V::set1(RMD_IV[4]) + l[0] + r[1];
+    h[4] = V::set1(RMD_IV[0]) + l[1] + r[2];
+}
+
+// يستهلك حالة SHA-256 كما هي: كلمات SHA كبيرة الطرف، و RIPEMD يقرأها صغيرة الطرف
+template <class V>
+static inline void ripemd160_mb_from_sha256(const V sha_state[8], V h[5]) {
+    V x[8];
+    for (int i = 0; i < 8; ++i) x[i] = V::bswap(sha_state[i]);
+    ripemd160_mb_32(x, h);
+}
+
+template <class V>
+static inline void ripemd160_mb_store(const V h[5], unsigned char (*digests)[20]) {
+    const int L = V::LANES;
+    uint32_t lanes[5][L];
+    for (int i = 0; i < 5; ++i) h[i].store(lanes[i]);
+    for (int l = 0; l < L; ++l)
+        for (int i = 0; i < 5; ++i) store_le32(digests[l] + i * 4, lanes[i][l]);
+}
+
+// hash160 = RIPEMD160(SHA256(msg)) لـ V::LANES رسالة، والحالة تنتقل بين المرحلتين في المسجلات
+template <class V>
+static void hash160_mb_lanes(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[20]) {
+    V s[8], h[5];
+    sha256_mb_hash_any(msgs, len, s);
+    ripemd160_mb_from_sha256(s, h);
+    ripemd160_mb_store(h, digests);
+}
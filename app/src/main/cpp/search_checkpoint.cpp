@@ -0,0 +1,230 @@
+#include "search_checkpoint.h"
+
+#include <android/log.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#define LOG_TAG "KeySearch"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+
+static const char CHECKPOINT_MAGIC[4] = {'K', 'S', 'C', 'P'};
+static const uint32_t CHECKPOINT_VERSION = 2;
+
+// الترويسة ثم CHECKPOINT_CURSORS مؤشرًا ثم bitmap بكلمات 64-بت. الإصدار 1 كان بحدود 64-بت
+struct CheckpointHeader {
+    char magic[4];
+    uint32_t version;
+    CheckpointIdentity id;
+};
+static_assert(sizeof(CheckpointHeader) == 136, "header layout");
+
+// نصف المؤشرات على الأكثر للمنقولة، فيبقى لكل عامل مؤشر
+static const size_t MAX_CARRIED_CURSORS = CHECKPOINT_CURSORS / 2;
+
+static void fill_header(CheckpointHeader& h, const CheckpointIdentity& id) {
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CHECKPOINT_MAGIC, sizeof(h.magic));
+    h.version = CHECKPOINT_VERSION;
+    h.id = id;
+}
+
+// FNV-1a لهوية البحث: اسم الملف، والترويسة تتحقق من التطابق الكامل
+static uint64_t identity_hash(const CheckpointHeader& h) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(&h);
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < sizeof(h); ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// نقاط استئناف البحوث الأخرى في dir: الخدمة تستأنف آخر بحث فقط، وكل ملف يبقى محجوزًا
+// بحجم bitmap كاملًا (حتى 16 MiB) إن لم يكتمل نطاقه. ملف بحث سابق ما زال عماله يكتبون فيه
+// يبقى مربوطًا حتى يُغلق
+static void prune_checkpoints(const std::string& dir, const char* keep) {
+    DIR* d = opendir(dir.c_str());
+    if (d == nullptr) return;
+    while (struct dirent* entry = readdir(d)) {
+        const char* name = entry->d_name;
+        const size_t len = strlen(name);
+        if (strncmp(name, "checkpoint_", 11) != 0 || len < 4 || strcmp(name + len - 4, ".bin") != 0) continue;
+        if (strcmp(name, keep) == 0) continue;
+        std::string path = dir;
+        if (path.back() != '/') path += "/";
+        path += name;
+        if (unlink(path.c_str()) == 0) LOGI("Checkpoint: removed stale %s", path.c_str());
+    }
+    closedir(d);
+}
+
+SearchCheckpoint::~SearchCheckpoint() {
+    if (map_ != nullptr) munmap(map_, map_size_);
+}
+
+std::shared_ptr<SearchCheckpoint> SearchCheckpoint::open(const std::string& dir, const CheckpointIdentity& id) {
+    if (dir.empty() || id.chunk_count == 0 || id.chunk_count > CHECKPOINT_MAX_CHUNKS) return nullptr;
+
+    CheckpointHeader h;
+    fill_header(h, id);
+    char name[64];
+    snprintf(name, sizeof(name), "checkpoint_%016llx.bin", (unsigned long long)identity_hash(h));
+    prune_checkpoints(dir, name);
+    std::string path = dir;
+    if (path.back() != '/') path += "/";
+    path += name;
+
+    std::shared_ptr<SearchCheckpoint> checkpoint(new SearchCheckpoint());
+    if (!checkpoint->map(path, id)) {
+        LOGI("Checkpoint: cannot map %s, search will not be resumable", path.c_str());
+        return nullptr;
+    }
+    checkpoint->carry_cursors();
+    char resumed[65];
+    u256_to_hex(checkpoint->resumed_keys_, resumed);
+    LOGI("Checkpoint %s: 0x%s keys already checked, %zu partial chunks to resume", path.c_str(), resumed,
+         checkpoint->resume_.size());
+    return checkpoint;
+}
+
+// يربط الملف إن طابقت ترويسته هذا البحث، وإلا يعيد إنشاءه فارغًا.
+// المساحة تُحجز كلها مسبقًا: الكتابة إلى صفحة مربوطة بلا مساحة على القرص تقتل العملية بـ SIGBUS
+bool SearchCheckpoint::map(const std::string& path, const CheckpointIdentity& id) {
+    const size_t words = (size_t)((id.chunk_count + 63) / 64);
+    const size_t size = sizeof(CheckpointHeader) + CHECKPOINT_CURSORS * sizeof(CursorSlot) + words * sizeof(uint64_t);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) return false;
+
+    CheckpointHeader want, have;
+    fill_header(want, id);
+    struct stat st;
+    bool valid = fstat(fd, &st) == 0 && (size_t)st.st_size == size &&
+                 pread(fd, &have, sizeof(have), 0) == (ssize_t)sizeof(have) && memcmp(&have, &want, sizeof(want)) == 0;
+    if (!valid) {
+        bool ok = ftruncate(fd, 0) == 0 && ftruncate(fd, (off_t)size) == 0 &&
+                  posix_fallocate(fd, 0, (off_t)size) == 0 &&
+                  pwrite(fd, &want, sizeof(want), 0) == (ssize_t)sizeof(want) && fsync(fd) == 0;
+        if (!ok) {
+            close(fd);
+            unlink(path.c_str());
+            return false;
+        }
+    }
+
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    path_ = path;
+    id_ = id;
+    map_ = map;
+    map_size_ = size;
+    cursors_ = reinterpret_cast<CursorSlot*>(static_cast<CheckpointHeader*>(map) + 1);
+    bitmap_ = reinterpret_cast<uint64_t*>(cursors_ + CHECKPOINT_CURSORS);
+    return true;
+}
+
+// مؤشرات التشغيل السابق التي تقع داخل قطعة غير مكتملة تُجمع (الأكبر لكل قطعة) وتنقل إلى أول
+// المؤشرات، فتبقى محفوظة حتى لو قُتل هذا التشغيل قبل أن يصل إلى قطعها
+void SearchCheckpoint::carry_cursors() {
+    for (size_t i = 0; i < CHECKPOINT_CURSORS; ++i) {
+        const CursorSlot& slot = cursors_[i];
+        if (slot.sequence & 1) continue;
+        U256 base = {{slot.base[0], slot.base[1], slot.base[2], slot.base[3]}};
+        U256 cursor;
+        if (u256_add_u64(cursor, base, slot.offset) != 0) continue;
+        if (u256_cmp(cursor, id_.start) <= 0 || u256_cmp(cursor, id_.end) > 0) continue;
+        U256 offset, index, within;
+        u256_sub(offset, cursor, id_.start);
+        u256_divmod(offset, id_.chunk_keys, index, within);
+        if (u256_is_zero(within) || chunk_done(index.d[0])) continue;
+        resume_.push_back(ResumePoint{index.d[0], cursor});
+    }
+    std::sort(resume_.begin(), resume_.end(), [](const ResumePoint& a, const ResumePoint& b) {
+        return a.chunk != b.chunk ? a.chunk < b.chunk : u256_cmp(a.cursor, b.cursor) < 0;
+    });
+    std::vector<ResumePoint> unique;
+    for (const ResumePoint& r : resume_) {
+        if (!unique.empty() && unique.back().chunk == r.chunk) unique.back().cursor = r.cursor;
+        else unique.push_back(r);
+    }
+    if (unique.size() > MAX_CARRIED_CURSORS) unique.resize(MAX_CARRIED_CURSORS);
+    resume_.swap(unique);
+
+    carried_ = resume_.size();
+    memset(cursors_, 0, CHECKPOINT_CURSORS * sizeof(CursorSlot));
+    for (size_t i = 0; i < carried_; ++i) memcpy(cursors_[i].base, resume_[i].cursor.d, sizeof(cursors_[i].base));
+
+    const size_t words = (size_t)((id_.chunk_count + 63) / 64);
+    uint64_t done = 0;
+    for (size_t i = 0; i < words; ++i) done += (uint64_t)__builtin_popcountll(bitmap_[i]);
+    u256_mul_u64(resumed_keys_, id_.chunk_keys, done);
+    if (chunk_done(id_.chunk_count - 1)) {
+        // القطعة الأخيرة أقصر من chunk_keys عادة: نطرح (أول مفتاح بعدها - end - 1)
+        U256 past_last;
+        u256_mul_u64(past_last, id_.chunk_keys, id_.chunk_count);
+        u256_add(past_last, past_last, id_.start);
+        U256 short_by;
+        u256_sub(short_by, past_last, id_.end);
+        u256_sub(short_by, short_by, u256_from_u64(1));
+        u256_sub(resumed_keys_, resumed_keys_, short_by);
+    }
+    for (const ResumePoint& r : resume_) {
+        U256 first, partial;
+        u256_mul_u64(first, id_.chunk_keys, r.chunk);
+        u256_add(first, first, id_.start);
+        u256_sub(partial, r.cursor, first);
+        u256_add(resumed_keys_, resumed_keys_, partial);
+    }
+}
+
+// bitmap والمؤشرات في ذاكرة مربوطة، فالوصول الذري بدوال __atomic بدل std::atomic
+bool SearchCheckpoint::chunk_done(uint64_t index) const {
+    return (__atomic_load_n(&bitmap_[index / 64], __ATOMIC_RELAXED) >> (index % 64)) & 1;
+}
+
+void SearchCheckpoint::mark_done(uint64_t index) {
+    __atomic_fetch_or(&bitmap_[index / 64], 1ull << (index % 64), __ATOMIC_RELAXED);
+}
+
+U256 SearchCheckpoint::resume_point(uint64_t index, const U256& first) const {
+    auto it = std::lower_bound(resume_.begin(), resume_.end(), index,
+                               [](const ResumePoint& r, uint64_t chunk) { return r.chunk < chunk; });
+    if (it != resume_.end() && it->chunk == index && u256_cmp(it->cursor, first) > 0) return it->cursor;
+    return first;
+}
+
+// موت العملية يترك ما سبق نقطةً ما من برنامج الخيط مكتوبًا وما بعدها لا، فيكفي أن يمنع الحاجز
+// المترجم والمعالج من تقديم كتابة الأساس على الـ sequence الفردي
+void SearchCheckpoint::begin_cursor(size_t worker, const U256& base) {
+    size_t index = carried_ + worker;
+    if (index >= CHECKPOINT_CURSORS) return;
+    CursorSlot& slot = cursors_[index];
+    uint64_t sequence = slot.sequence | 1;
+    __atomic_store_n(&slot.sequence, sequence, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (int i = 0; i < 4; ++i) __atomic_store_n(&slot.base[i], base.d[i], __ATOMIC_RELAXED);
+    __atomic_store_n(&slot.offset, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot.sequence, sequence + 1, __ATOMIC_RELEASE);
+}
+
+void SearchCheckpoint::set_cursor(size_t worker, uint64_t offset) {
+    size_t index = carried_ + worker;
+    if (index < CHECKPOINT_CURSORS) __atomic_store_n(&cursors_[index].offset, offset, __ATOMIC_RELAXED);
+}
+
+void SearchCheckpoint::flush() {
+    msync(map_, map_size_, MS_ASYNC);
+}
+
+void SearchCheckpoint::remove() {
+    unlink(path_.c_str());
+}
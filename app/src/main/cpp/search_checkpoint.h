@@ -0,0 +1,89 @@
+#pragma once
+
+// نقطة استئناف البحث في dir/checkpoint_<hash>.bin، مربوطة بالذاكرة (MAP_SHARED):
+//   - bitmap: بت لكل قطعة من قطع RangeScheduler، يُضبط حين تُفحص القطعة كلها
+//   - مؤشر لكل عامل: أول مفتاح لم يُفحص في القطعة التي يعمل عليها، أساس 256-بت يُكتب مرة لكل مقطع
+//     وإزاحة 64-بت منه تُكتب بعد كل دفعة
+// الكتابة مخزن عادي في صفحات مشتركة، فتبقى في page cache إن قُتلت العملية، والنواة تكتب
+// الصفحة المتسخة مرة في كل دورة writeback مهما تكرر تعديلها. flush() يطلب الكتابة عند الإيقاف.
+// إعادة نفس البحث (النطاق، حجم القطعة، الأهداف، الصيغة) تتخطى القطع المكتملة وتكمل الجزئية من مؤشرها.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "uint256.h"
+
+// أقصى عدد قطع لنقطة استئناف (bitmap بـ 16 MiB)؛ النطاقات الأكبر تُقسم إلى قطع أكبر
+static const uint64_t CHECKPOINT_MAX_CHUNKS = 1ull << 27;
+// مؤشرات العمال الحاليين مع المؤشرات المنقولة من التشغيل السابق
+static const size_t CHECKPOINT_CURSORS = 256;
+
+struct CheckpointIdentity {
+    U256 start;
+    U256 end;
+    U256 chunk_keys;
+    uint64_t chunk_count;
+    unsigned char targets[20];      // TargetSet::fingerprint
+    uint32_t pubkey_mode;
+};
+
+class SearchCheckpoint {
+public:
+    ~SearchCheckpoint();
+
+    // يفتح نقطة استئناف هذا البحث أو ينشئها فارغة. يعيد nullptr إن تعذر الملف
+    // أو تجاوز عدد القطع CHECKPOINT_MAX_CHUNKS؛ البحث يعمل عندها دون استئناف.
+    // نقاط استئناف البحوث الأخرى في dir تُحذف: يُستأنف آخر بحث بدأ فقط.
+    static std::shared_ptr<SearchCheckpoint> open(const std::string& dir, const CheckpointIdentity& id);
+
+    bool chunk_done(uint64_t index) const;
+    void mark_done(uint64_t index);
+
+    // أول مفتاح يلزم فحصه في القطعة index التي تبدأ بـ first: بعد مؤشر محفوظ من تشغيل سابق إن وُجد
+    U256 resume_point(uint64_t index, const U256& first) const;
+    // العامل worker يبدأ مقطعًا من base في قطعته الحالية، ولم يفحص منه شيئًا بعد
+    void begin_cursor(size_t worker, const U256& base);
+    // العامل worker فحص كل مفاتيح قطعته الحالية قبل base + offset. مخزن 64-بت واحد لكل دفعة
+    void set_cursor(size_t worker, uint64_t offset);
+
+    // مفاتيح فحصتها التشغيلات السابقة (قطع مكتملة وأجزاء قبل المؤشرات)، محسوبة عند الفتح
+    const U256& resumed_keys() const { return resumed_keys_; }
+
+    // يطلب كتابة الصفحات المتسخة دون انتظار
+    void flush();
+    // يحذف الملف بعد اكتمال النطاق كله، فإعادة البحث نفسه تبدأ من جديد
+    void remove();
+
+private:
+    // الأساس يتغير مع offset = 0 بين sequence فردي وزوجي، فالخانة التي قطع موتُ العملية كتابتها تُتجاهل.
+    // الإزاحة وحدها كلمة واحدة لا تتمزق
+    struct CursorSlot {
+        uint64_t sequence;
+        uint64_t base[4];
+        uint64_t offset;
+    };
+    struct ResumePoint {
+        uint64_t chunk;
+        U256 cursor;
+    };
+
+    SearchCheckpoint() = default;
+    SearchCheckpoint(const SearchCheckpoint&) = delete;
+    SearchCheckpoint& operator=(const SearchCheckpoint&) = delete;
+
+    bool map(const std::string& path, const CheckpointIdentity& id);
+    void carry_cursors();
+
+    std::string path_;
+    CheckpointIdentity id_;
+    void* map_ = nullptr;
+    size_t map_size_ = 0;
+    CursorSlot* cursors_ = nullptr; // CHECKPOINT_CURSORS مؤشرًا، 0 = لا شيء
+    uint64_t* bitmap_ = nullptr;
+    size_t carried_ = 0;            // المؤشرات [0, carried_) من التشغيل السابق، وبعدها مؤشرات العمال
+    std::vector<ResumePoint> resume_;   // من التشغيل السابق، مرتبة بالقطعة
+    U256 resumed_keys_ = {};
+};
@@ -0,0 +1,448 @@
+#include "search_pipeline.h"
+
+#include <cstring>
+
+SearchBatch::SearchBatch(size_t batch_capacity, PubkeyMode mode)
+    : capacity(batch_capacity), x(batch_capacity), y(batch_capacity) {
+    // المخزن الأول للمفاتيح المضغوطة (33 بايت، كتلة SHA-256 واحدة)
+    // والثاني لغير المضغوطة (65 بايت، كتلتان) من نفس النقطة
+    if (mode != PubkeyMode::Uncompressed) enable_compressed();
+    if (mode != PubkeyMode::Compressed) {
+        pub65.resize(capacity * 65);
+        msgs65.resize(capacity);
+        for (size_t i = 0; i < capacity; ++i) msgs65[i] = &pub65[i * 65];
+    }
+    digests.resize(capacity * HASH160_LEN);
+}
+
+void SearchBatch::enable_compressed() {
+    if (!pub33.empty()) return;
+    pub33.resize(capacity * 33);
+    msgs33.resize(capacity);
+    for (size_t i = 0; i < capacity; ++i) msgs33[i] = &pub33[i * 33];
+}
+
+// البايتان الأوليان ثابتان (OP_0، دفع 20 بايت)، فالمرحلة لا تنسخ إلا الملخص
+void SearchBatch::enable_scripts() {
+    if (!script22.empty()) return;
+    script22.resize(capacity * 22);
+    msgs22.resize(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        script22[i * 22] = 0x00;
+        script22[i * 22 + 1] = 0x14;
+        msgs22[i] = &script22[i * 22];
+    }
+    script_digests.resize(capacity * HASH160_LEN);
+}
+
+void SearchBatch::enable_taproot() {
+    if (!tap_x.empty()) return;
+    tap_x.resize(capacity * 32);
+    msgs_tap.resize(capacity);
+    for (size_t i = 0; i < capacity; ++i) msgs_tap[i] = &tap_x[i * 32];
+    tweaks.resize(capacity * 32);
+    tap_scalars.resize(capacity);
+    tap_points.resize(capacity);
+    tap_dx.resize(capacity);
+    tap_scratch.resize(capacity);
+    tap_outputs.resize(capacity * 32);
+}
+
+void SearchBatch::enable_points() {
+    point_keys.resize(capacity * 33);
+}
+
+static void derive_group_walk(EcGroupWalk& walk, SearchBatch& batch) {
+    walk.next_group(batch.x.data(), batch.y.data());
+}
+
+static inline void serialize_compressed(SearchBatch& batch) {
+    for (size_t j = 0; j < batch.count; ++j) {
+        unsigned char* out = &batch.pub33[j * 33];
+        out[0] = fe_is_odd(batch.y[j]) ? 0x03 : 0x02;
+        fe_to_be_bytes(batch.x[j], out + 1);
+    }
+}
+
+static inline void serialize_uncompressed(SearchBatch& batch) {
+    for (size_t j = 0; j < batch.count; ++j) {
+        unsigned char* out = &batch.pub65[j * 65];
+        out[0] = 0x04;
+        fe_to_be_bytes(batch.x[j], out + 1);
+        fe_to_be_bytes(batch.y[j], out + 33);
+    }
+}
+
+static void serialize_scalar(SearchBatch& batch, size_t len) {
+    if (len == 33) serialize_compressed(batch);
+    else serialize_uncompressed(batch);
+}
+
+// الدفعة كلها تمر معًا عبر SHA-256 ثم RIPEMD-160 في مسارات SIMD
+static void hash_multibuffer(SearchBatch& batch, size_t len, SimdBackend backend) {
+    const unsigned char* const* msgs = len == 33 ? batch.msgs33.data() : batch.msgs65.data();
+    hash160_mb(backend, msgs, len, batch.count, (unsigned char (*)[HASH160_LEN])batch.digests.data());
+}
+
+static void hash_redeem_scripts(SearchBatch& batch, SimdBackend backend) {
+    for (size_t j = 0; j < batch.count; ++j) {
+        memcpy(&batch.script22[j * 22 + 2], &batch.digests[j * HASH160_LEN], HASH160_LEN);
+    }
+    hash160_mb(backend, batch.msgs22.data(), 22, batch.count,
+               (unsigned char (*)[HASH160_LEN])batch.script_digests.data());
+}
+
+// BIP-341 بلا شجرة سكربتات: Q = P_even + H_TapTweak(P.x)*G، والمقارنة بـ x لـ Q.
+// الـ tweak ضغطة SHA-256 واحدة متعددة المسارات، و tG بنوافذ جدول المضاعفات مجموعةً
+// على نقاط الدفعة كلها بانعكاس مشترك لكل نافذة
+static void taproot_outputs(SearchBatch& batch, const GeneratorTable& table, SimdBackend backend) {
+    const size_t count = batch.count;
+    for (size_t j = 0; j < count; ++j) fe_to_be_bytes(batch.x[j], &batch.tap_x[j * 32]);
+    tap_tweak_mb(backend, batch.msgs_tap.data(), count, (unsigned char (*)[32])batch.tweaks.data());
+
+    for (size_t j = 0; j < count; ++j) {
+        AffinePoint& p = batch.tap_points[j];
+        p.x = batch.x[j];
+        p.infinity = false;
+        if (fe_is_odd(batch.y[j])) fe_neg(p.y, batch.y[j]);
+        else p.y = batch.y[j];
+        // tweak >= n لا يعطي مفتاحًا ناتجًا (احتماله ~2^-128): يُجمع 0 ويُصفَّر الناتج أدناه
+        batch.tap_scalars[j] = u256_from_be_bytes(&batch.tweaks[j * 32]);
+        if (u256_cmp(batch.tap_scalars[j], SECP256K1_N) >= 0) batch.tap_scalars[j] = U256{};
+    }
+    if (!ec_batch_add_mul_generator(batch.tap_points.data(), batch.tap_scalars.data(), count, table,
+                                    batch.tap_dx.data(), batch.tap_scratch.data())) {
+        // جمع منحل في إحدى النوافذ: الدفعة كلها بالجمع المختلط الذي يعالج كل الحالات
+        for (size_t j = 0; j < count; ++j) {
+            AffinePoint p;
+            p.x = batch.x[j];
+            p.infinity = false;
+            if (fe_is_odd(batch.y[j])) fe_neg(p.y, batch.y[j]);
+            else p.y = batch.y[j];
+            JacobianPoint q;
+            table.mul_generator_jacobian(q, batch.tap_scalars[j]);
+            ec_jacobian_add_affine(q, q, p);
+            ec_jacobian_to_affine(batch.tap_points[j], q);
+        }
+    }
+
+    // لا نقطة على المنحنى بـ x = 0، فالأصفار لا تطابق أي هدف
+    for (size_t j = 0; j < count; ++j) {
+        unsigned char* out = &batch.tap_outputs[j * 32];
+        if (batch.tap_points[j].infinity || u256_is_zero(batch.tap_scalars[j])) memset(out, 0, 32);
+        else fe_to_be_bytes(batch.tap_points[j].x, out);
+    }
+}
+
+static void serialize_point_keys(SearchBatch& batch) {
+    for (size_t j = 0; j < batch.count; ++j) {
+        unsigned char* out = &batch.point_keys[j * 33];
+        fe_to_be_bytes(batch.x[j], out);
+        out[32] = fe_is_odd(batch.y[j]) ? 1 : 0;
+    }
+}
+
+static size_t match_target_set(const SearchBatch& batch, TargetKind kind, size_t from, const TargetSet& targets) {
+    const unsigned char* digests = batch.digests_of(kind);
+    const size_t len = target_digest_len(kind);
+    for (size_t j = from; j < batch.count; ++j) {
+        if (targets.find(kind, &digests[j * len]) >= 0) return j;
+    }
+    return batch.count;
+}
+
+PipelineStages default_pipeline_stages() {
+    PipelineStages stages;
+    stages.derive = derive_group_walk;
+    stages.serialize = serialize_scalar;
+    stages.hash = hash_multibuffer;
+    stages.script_hash = hash_redeem_scripts;
+    stages.taproot = taproot_outputs;
+    stages.point_key = serialize_point_keys;
+    stages.match = match_target_set;
+    return stages;
+}
+
+// طرق المطابقة في النواة المخصصة: find يعيد رقم الهدف أو -1، و enabled = false يحذف
+// المرحلة التي لا أهداف لها عند الترجمة
+namespace {
+
+struct NoMatch {
+    static constexpr bool enabled = false;
+    static constexpr size_t LEN = 0;
+    NoMatch(const TargetSet&, const unsigned char*, int) {}
+    int find(const unsigned char*) const { return -1; }
+    int find_point(const FieldElem&, const FieldElem&) const { return -1; }
+};
+
+// هدف واحد: أول 8 بايت ترفض كل المفاتيح تقريبًا بمقارنة واحدة، والباقي عند تطابقها فقط
+template <TargetKind Kind>
+struct SingleMatch {
+    static constexpr bool enabled = true;
+    static constexpr size_t LEN = target_digest_len(Kind);
+    SingleMatch(const TargetSet&, const unsigned char* digest, int target_id) : id(target_id) {
+        memcpy(&hi, digest, 8);
+        memcpy(rest, digest + 8, sizeof(rest));
+    }
+    int find(const unsigned char* digest) const {
+        uint64_t a;
+        memcpy(&a, digest, 8);
+        if (a != hi) return -1;
+        return memcmp(digest + 8, rest, sizeof(rest)) == 0 ? id : -1;
+    }
+    uint64_t hi;
+    unsigned char rest[LEN - 8];
+    int id;
+};
+
+template <TargetKind Kind>
+struct SetMatch {
+    static constexpr bool enabled = true;
+    static constexpr size_t LEN = target_digest_len(Kind);
+    SetMatch(const TargetSet& target_set, const unsigned char*, int) : targets(target_set) {}
+    int find(const unsigned char* digest) const { return targets.find(Kind, digest); }
+    const TargetSet& targets;
+};
+
+// مفتاح عام واحد: أعلى 64 بت من x كما خرجت من المشي ترفض كل المفاتيح تقريبًا،
+// والنقطة كاملة (بقية x وزوجية y) تؤكد المطابقة
+struct SinglePointMatch {
+    static constexpr bool enabled = true;
+    SinglePointMatch(const TargetSet&, const unsigned char* digest, int target_id) : id(target_id) {
+        U256 x = u256_from_be_bytes(digest);
+        memcpy(limbs, x.d, sizeof(limbs));
+        odd = digest[32] != 0;
+    }
+    int find_point(const FieldElem& x, const FieldElem& y) const {
+        if (x.n[3] != limbs[3]) return -1;
+        return x.n[2] == limbs[2] && x.n[1] == limbs[1] && x.n[0] == limbs[0] && fe_is_odd(y) == odd ? id : -1;
+    }
+    uint64_t limbs[4];
+    bool odd;
+    int id;
+};
+
+// مجموعة مفاتيح عامة: بت البادئة من أعلى 16 بت لـ x مباشرة، والتسلسل والبحث الكامل
+// (أول 64 بت ثم البقية) لمن يجتازه فقط
+struct PointSetMatch {
+    static constexpr bool enabled = true;
+    PointSetMatch(const TargetSet& target_set, const unsigned char*, int) : targets(target_set) {}
+    int find_point(const FieldElem& x, const FieldElem& y) const {
+        if (!targets.maybe(TargetKind::PublicKey, (uint32_t)(x.n[3] >> 48))) return -1;
+        unsigned char key[33];
+        fe_to_be_bytes(x, key);
+        key[32] = fe_is_odd(y) ? 1 : 0;
+        return targets.find(TargetKind::PublicKey, key);
+    }
+    const TargetSet& targets;
+};
+
+template <class Match>
+inline void match_points(const Match& match, const SearchBatch& batch, std::vector<PipelineHit>& hits) {
+    for (size_t j = 0; j < batch.count; ++j) {
+        int target = match.find_point(batch.x[j], batch.y[j]);
+        if (__builtin_expect(target >= 0, 0)) hits.push_back(PipelineHit{j, "known", (size_t)target});
+    }
+}
+
+template <class Match>
+inline void match_digests(const Match& match, const unsigned char* digests, size_t count, const char* format,
+                          std::vector<PipelineHit>& hits) {
+    for (size_t j = 0; j < count; ++j) {
+        int target = match.find(&digests[j * Match::LEN]);
+        if (__builtin_expect(target >= 0, 0)) hits.push_back(PipelineHit{j, format, (size_t)target});
+    }
+}
+
+}  // namespace
+
+SearchPipeline::SearchPipeline(const GeneratorTable& table, size_t batch_size, PubkeyMode mode,
+                               std::shared_ptr<const TargetSet> targets, SimdBackend backend,
+                               const PipelineStages& stages)
+    : table_(table), walk_(table, batch_size), batch_(batch_size, mode), stages_(stages), mode_(mode), backend_(backend),
+      targets_(std::move(targets)) {
+    const PipelineStages defaults = default_pipeline_stages();
+    default_stages_ = stages.derive == defaults.derive && stages.serialize == defaults.serialize &&
+                      stages.hash == defaults.hash && stages.script_hash == defaults.script_hash &&
+                      stages.taproot == defaults.taproot && stages.point_key == defaults.point_key &&
+                      stages.match == defaults.match;
+    select_kernel();
+}
+
+void SearchPipeline::set_targets(std::shared_ptr<const TargetSet> targets) {
+    targets_ = std::move(targets);
+    select_kernel();
+}
+
+void SearchPipeline::select_kernel() {
+    if (targets_->has(TargetKind::WitnessKeyHash) || targets_->has(TargetKind::ScriptHash)) batch_.enable_compressed();
+    if (targets_->has(TargetKind::ScriptHash)) batch_.enable_scripts();
+    if (targets_->has(TargetKind::TaprootOutput)) batch_.enable_taproot();
+    if (targets_->has(TargetKind::PublicKey) && !default_stages_) batch_.enable_points();
+    single_id_ = -1;
+    if (!default_stages_) {
+        kernel_ = &SearchPipeline::run_stages;
+        return;
+    }
+    switch (mode_) {
+        case PubkeyMode::Compressed: kernel_ = kernel_for_mode<PubkeyMode::Compressed>(); break;
+        case PubkeyMode::Uncompressed: kernel_ = kernel_for_mode<PubkeyMode::Uncompressed>(); break;
+        case PubkeyMode::Both: kernel_ = kernel_for_mode<PubkeyMode::Both>(); break;
+    }
+}
+
+// هدف واحد يُقارن مباشرة، وإلا مجموعة لكل نوع موجود ولا شيء لغيره
+template <PubkeyMode Mode>
+SearchPipeline::Kernel SearchPipeline::kernel_for_mode() {
+    if (targets_->single(TargetKind::KeyHash, single_digest_, single_id_)) {
+        return &SearchPipeline::run_kernel<Mode, SingleMatch<TargetKind::KeyHash>, NoMatch, NoMatch, NoMatch, NoMatch>;
+    }
+    if (targets_->single(TargetKind::WitnessKeyHash, single_digest_, single_id_)) {
+        return &SearchPipeline::run_kernel<Mode, NoMatch, SingleMatch<TargetKind::WitnessKeyHash>, NoMatch, NoMatch,
+                                           NoMatch>;
+    }
+    if (targets_->single(TargetKind::ScriptHash, single_digest_, single_id_)) {
+        return &SearchPipeline::run_kernel<Mode, NoMatch, NoMatch, SingleMatch<TargetKind::ScriptHash>, NoMatch,
+                                           NoMatch>;
+    }
+    if (targets_->single(TargetKind::TaprootOutput, single_digest_, single_id_)) {
+        return &SearchPipeline::run_kernel<Mode, NoMatch, NoMatch, NoMatch, SingleMatch<TargetKind::TaprootOutput>,
+                                           NoMatch>;
+    }
+    if (targets_->single(TargetKind::PublicKey, single_digest_, single_id_)) {
+        return &SearchPipeline::run_kernel<Mode, NoMatch, NoMatch, NoMatch, NoMatch, SinglePointMatch>;
+    }
+    if (targets_->has(TargetKind::KeyHash)) return kernel_with_keys<Mode, SetMatch<TargetKind::KeyHash>>();
+    return kernel_with_keys<Mode, NoMatch>();
+}
+
+template <PubkeyMode Mode, class KeyMatch>
+SearchPipeline::Kernel SearchPipeline::kernel_with_keys() {
+    if (targets_->has(TargetKind::WitnessKeyHash)) {
+        return kernel_with_witness<Mode, KeyMatch, SetMatch<TargetKind::WitnessKeyHash>>();
+    }
+    return kernel_with_witness<Mode, KeyMatch, NoMatch>();
+}
+
+template <PubkeyMode Mode, class KeyMatch, class WitnessMatch>
+SearchPipeline::Kernel SearchPipeline::kernel_with_witness() {
+    if (targets_->has(TargetKind::ScriptHash)) {
+        return kernel_with_scripts<Mode, KeyMatch, WitnessMatch, SetMatch<TargetKind::ScriptHash>>();
+    }
+    return kernel_with_scripts<Mode, KeyMatch, WitnessMatch, NoMatch>();
+}
+
+template <PubkeyMode Mode, class KeyMatch, class WitnessMatch, class ScriptMatch>
+SearchPipeline::Kernel SearchPipeline::kernel_with_scripts() {
+    if (targets_->has(TargetKind::TaprootOutput)) {
+        return kernel_with_taproot<Mode, KeyMatch, WitnessMatch, ScriptMatch, SetMatch<TargetKind::TaprootOutput>>();
+    }
+    return kernel_with_taproot<Mode, KeyMatch, WitnessMatch, ScriptMatch, NoMatch>();
+}
+
+template <PubkeyMode Mode, class KeyMatch, class WitnessMatch, class ScriptMatch, class TapMatch>
+SearchPipeline::Kernel SearchPipeline::kernel_with_taproot() {
+    if (targets_->has(TargetKind::PublicKey)) {
+        return &SearchPipeline::run_kernel<Mode, KeyMatch, WitnessMatch, ScriptMatch, TapMatch, PointSetMatch>;
+    }
+    return &SearchPipeline::run_kernel<Mode, KeyMatch, WitnessMatch, ScriptMatch, TapMatch, NoMatch>;
+}
+
+void SearchPipeline::reset(const U256& start) {
+    // ضرب كامل مرة واحدة لبداية النطاق، ثم مجموعات C ± iG بانعكاس مشترك
+    walk_.reset(start);
+    next_key_ = start;
+}
+
+void SearchPipeline::next_batch(size_t n) {
+    batch_.first_key = next_key_;
+    u256_add_u64(next_key_, next_key_, batch_.capacity);
+    // المشي يتقدم دائمًا مجموعة كاملة، والمراحل التالية تعمل على أول n فقط
+    stages_.derive(walk_, batch_);
+    batch_.count = n < batch_.capacity ? n : batch_.capacity;
+}
+
+// نفس مراحل run_stages، والصيغة وأنواع الأهداف معروفة عند الترجمة
+template <PubkeyMode Mode, class KeyMatch, class WitnessMatch, class ScriptMatch, class TapMatch, class PointMatch>
+void SearchPipeline::run_kernel(std::vector<PipelineHit>& hits) {
+    const KeyMatch key_match(*targets_, single_digest_, single_id_);
+    const WitnessMatch witness_match(*targets_, single_digest_, single_id_);
+    const ScriptMatch script_match(*targets_, single_digest_, single_id_);
+    const TapMatch tap_match(*targets_, single_digest_, single_id_);
+    const PointMatch point_match(*targets_, single_digest_, single_id_);
+    // المفاتيح العامة المعروفة تُقارن بنقاط المشي قبل أي تسلسل أو تجزئة
+    if constexpr (PointMatch::enabled) match_points(point_match, batch_, hits);
+    // P2WPKH و P2SH-P2WPKH لا يلتزمان إلا بالمفتاح المضغوط، فيُحسب لهما حتى في البحث غير المضغوط
+    constexpr bool compressed_keys = Mode != PubkeyMode::Uncompressed && KeyMatch::enabled;
+    if constexpr (compressed_keys || WitnessMatch::enabled || ScriptMatch::enabled) {
+        serialize_compressed(batch_);
+        hash160_mb(backend_, batch_.msgs33.data(), 33, batch_.count,
+                   (unsigned char (*)[HASH160_LEN])batch_.digests.data());
+        if constexpr (compressed_keys) {
+            match_digests(key_match, batch_.digests.data(), batch_.count, "compressed", hits);
+        }
+        if constexpr (WitnessMatch::enabled) {
+            match_digests(witness_match, batch_.digests.data(), batch_.count, "compressed", hits);
+        }
+        if constexpr (ScriptMatch::enabled) {
+            hash_redeem_scripts(batch_, backend_);
+            match_digests(script_match, batch_.script_digests.data(), batch_.count, "compressed", hits);
+        }
+    }
+    if constexpr (Mode != PubkeyMode::Compressed && KeyMatch::enabled) {
+        serialize_uncompressed(batch_);
+        hash160_mb(backend_, batch_.msgs65.data(), 65, batch_.count,
+                   (unsigned char (*)[HASH160_LEN])batch_.digests.data());
+        match_digests(key_match, batch_.digests.data(), batch_.count, "uncompressed", hits);
+    }
+    // المفتاح x-only لا يتأثر بصيغة المفتاح العام
+    if constexpr (TapMatch::enabled) {
+        taproot_outputs(batch_, table_, backend_);
+        match_digests(tap_match, batch_.tap_outputs.data(), batch_.count, "taproot", hits);
+    }
+}
+
+void SearchPipeline::run_stages(std::vector<PipelineHit>& hits) {
+    // عناوين P2WPKH و P2SH-P2WPKH لا تقبل إلا المفتاح المضغوط: تُحسب لها ملخصاته في أي صيغة،
+    // ولا تُقارن بغير المضغوط
+    const bool compressed_keys = mode_ != PubkeyMode::Uncompressed && targets_->has(TargetKind::KeyHash);
+    const bool witness_keys = targets_->has(TargetKind::WitnessKeyHash);
+    const bool script_hashes = targets_->has(TargetKind::ScriptHash);
+    if (compressed_keys || witness_keys || script_hashes) {
+        stages_.serialize(batch_, 33);
+        stages_.hash(batch_, 33, backend_);
+        if (compressed_keys) collect_hits(TargetKind::KeyHash, "compressed", hits);
+        if (witness_keys) collect_hits(TargetKind::WitnessKeyHash, "compressed", hits);
+        if (script_hashes) {
+            stages_.script_hash(batch_, backend_);
+            collect_hits(TargetKind::ScriptHash, "compressed", hits);
+        }
+    }
+    if (mode_ != PubkeyMode::Compressed && targets_->has(TargetKind::KeyHash)) {
+        stages_.serialize(batch_, 65);
+        stages_.hash(batch_, 65, backend_);
+        collect_hits(TargetKind::KeyHash, "uncompressed", hits);
+    }
+    if (targets_->has(TargetKind::TaprootOutput)) {
+        stages_.taproot(batch_, table_, backend_);
+        collect_hits(TargetKind::TaprootOutput, "taproot", hits);
+    }
+    if (targets_->has(TargetKind::PublicKey)) {
+        stages_.point_key(batch_);
+        collect_hits(TargetKind::PublicKey, "known", hits);
+    }
+}
+
+// كل مطابقات الصيغة الحالية: المطابقة نادرة جدًا، فإعادة البحث عن رقم الهدف لا تكلف شيئًا
+void SearchPipeline::collect_hits(TargetKind kind, const char* format, std::vector<PipelineHit>& hits) {
+    const unsigned char* digests = batch_.digests_of(kind);
+    const size_t len = target_digest_len(kind);
+    for (size_t j = stages_.match(batch_, kind, 0, *targets_); j < batch_.count;
+         j = stages_.match(batch_, kind, j + 1, *targets_)) {
+        PipelineHit hit;
+        hit.index = j;
+        hit.format = format;
+        hit.target = (size_t)targets_->find(kind, &digests[j * len]);
+        hits.push_back(hit);
+    }
+}
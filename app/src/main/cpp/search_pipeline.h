@@ -0,0 +1,154 @@
+#pragma once
+
+// خط معالجة البحث على دفعات: توليد المفاتيح → نقاط المنحنى → التجزئة → المطابقة.
+// كل مرحلة تقرأ مصفوفات المرحلة السابقة في SearchBatch وتكتب مصفوفاتها (تخطيط SoA)،
+// والمخازن تُحجز مرة واحدة لكل خيط بحجم يبقى داخل L2.
+// مرحلتا تجزئة السكربت (P2SH-P2WPKH) والـ tweak (P2TR) لا تُحجزان ولا تعملان إلا إن وُجد هدف من نوعهما.
+// مع المراحل الافتراضية تعمل الدفعة في نواة مخصصة بالقوالب لصيغة المفتاح وأنواع الأهداف
+// وطريقة المطابقة، تُختار مرة لكل بحث، فلا تفرع على الصيغة ولا استدعاء غير مباشر داخلها.
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "ec_batch.h"
+#include "hash_mb.h"
+#include "target_set.h"
+#include "uint256.h"
+
+// صيغة المفتاح العام التي تُجزّأ لكل مفتاح خاص (نفس القيم في SearchService.kt)
+enum class PubkeyMode { Compressed = 0, Uncompressed = 1, Both = 2 };
+
+struct SearchBatch {
+    SearchBatch(size_t capacity, PubkeyMode mode);
+
+    size_t capacity;
+    size_t count = 0;
+    // المفاتيح الخاصة متتالية: first_key + j للعنصر j، فلا حاجة لمصفوفة أعداد كاملة
+    U256 first_key;
+
+    std::vector<FieldElem> x, y;                // إحداثيات النقطة j
+    std::vector<unsigned char> pub33, pub65;    // المفاتيح العامة المسلسلة
+    std::vector<const unsigned char*> msgs33, msgs65;
+    std::vector<unsigned char> digests;         // hash160 للعنصر j في digests[j * 20]
+
+    // سكربت الاسترداد 0x00 0x14 <hash160> لكل عنصر وملخصه، بعد enable_scripts فقط
+    std::vector<unsigned char> script22;
+    std::vector<const unsigned char*> msgs22;
+    std::vector<unsigned char> script_digests;
+
+    // P2TR بعد enable_taproot فقط: x-only للمفتاح الداخلي P، الـ tweak t، النقطة P_even + tG،
+    // و x الناتج في tap_outputs[j * 32]
+    std::vector<unsigned char> tap_x;
+    std::vector<const unsigned char*> msgs_tap;
+    std::vector<unsigned char> tweaks;
+    std::vector<U256> tap_scalars;
+    std::vector<AffinePoint> tap_points;
+    std::vector<FieldElem> tap_dx, tap_scratch;
+    std::vector<unsigned char> tap_outputs;
+
+    // x || زوجية y (33 بايت) لأهداف المفاتيح العامة، في المسار العام فقط: النواة المخصصة
+    // تقارن x من المشي مباشرة
+    std::vector<unsigned char> point_keys;
+
+    // المخزن المضغوط في البحث غير المضغوط، لأهداف لا يلتزم بها إلا المفتاح المضغوط
+    void enable_compressed();
+    void enable_scripts();
+    void enable_taproot();
+    void enable_points();
+    // ملخصات النوع kind، كل ملخص target_digest_len(kind) بايت
+    const unsigned char* digests_of(TargetKind kind) const {
+        switch (kind) {
+            case TargetKind::ScriptHash: return script_digests.data();
+            case TargetKind::TaprootOutput: return tap_outputs.data();
+            case TargetKind::PublicKey: return point_keys.data();
+            default: return digests.data();
+        }
+    }
+};
+
+// المراحل القابلة للاستبدال: يمكن خلط نوى عادية و SIMD ومسرَّعة عتاديًا حسب المنصة
+struct PipelineStages {
+    // first_key .. first_key + capacity - 1 → x/y
+    void (*derive)(EcGroupWalk& walk, SearchBatch& batch);
+    // x/y → pub33 (len = 33) أو pub65 (len = 65)
+    void (*serialize)(SearchBatch& batch, size_t len);
+    // pub33 أو pub65 → digests
+    void (*hash)(SearchBatch& batch, size_t len, SimdBackend backend);
+    // digests (للمفاتيح المضغوطة) → script22 → script_digests
+    void (*script_hash)(SearchBatch& batch, SimdBackend backend);
+    // x/y → tap_x → tweaks → tap_points → tap_outputs
+    void (*taproot)(SearchBatch& batch, const GeneratorTable& table, SimdBackend backend);
+    // x/y → point_keys
+    void (*point_key)(SearchBatch& batch);
+    // ملخصات النوع kind → فهرس أول مطابقة من from فصاعدًا، أو count
+    size_t (*match)(const SearchBatch& batch, TargetKind kind, size_t from, const TargetSet& targets);
+};
+
+PipelineStages default_pipeline_stages();
+
+struct PipelineHit {
+    size_t index;           // المفتاح first_key + index
+    const char* format;     // "compressed" أو "uncompressed" أو "taproot" أو "known"
+    size_t target;          // رقم الهدف بترتيب إدخاله
+};
+
+class SearchPipeline {
+public:
+    // batch_size زوجي: الدفعة هي مجموعة مشي واحدة حول نقطة مركزية
+    SearchPipeline(const GeneratorTable& table, size_t batch_size, PubkeyMode mode,
+                   std::shared_ptr<const TargetSet> targets, SimdBackend backend,
+                   const PipelineStages& stages = default_pipeline_stages());
+
+    void reset(const U256& start);
+
+    // الجلسة تعيد استخدام الخط نفسه (مخازنه ومضاعفاته) من بحث لآخر ولا تغير إلا الأهداف
+    void set_targets(std::shared_ptr<const TargetSet> targets);
+
+    // يمرر الدفعة التالية عبر كل المراحل، ويفحص أول n مفتاحًا منها فقط (الدفعة الأخيرة من النطاق).
+    // يضع في hits كل المطابقات (لأكثر من هدف) ويعيد true إن وُجدت واحدة على الأقل.
+    bool run_batch(size_t n, std::vector<PipelineHit>& hits) {
+        next_batch(n);
+        hits.clear();
+        (this->*kernel_)(hits);
+        return !hits.empty();
+    }
+
+    size_t batch_size() const { return batch_.capacity; }
+
+private:
+    using Kernel = void (SearchPipeline::*)(std::vector<PipelineHit>& hits);
+
+    void next_batch(size_t n);
+    void select_kernel();
+    template <PubkeyMode Mode>
+    Kernel kernel_for_mode();
+    template <PubkeyMode Mode, class KeyMatch>
+    Kernel kernel_with_keys();
+    template <PubkeyMode Mode, class KeyMatch, class WitnessMatch>
+    Kernel kernel_with_witness();
+    template <PubkeyMode Mode, class KeyMatch, class WitnessMatch, class ScriptMatch>
+    Kernel kernel_with_scripts();
+    template <PubkeyMode Mode, class KeyMatch, class WitnessMatch, class ScriptMatch, class TapMatch>
+    Kernel kernel_with_taproot();
+    template <PubkeyMode Mode, class KeyMatch, class WitnessMatch, class ScriptMatch, class TapMatch, class PointMatch>
+    void run_kernel(std::vector<PipelineHit>& hits);
+
+    // المسار العام عبر stages_، للمراحل المستبدلة
+    void run_stages(std::vector<PipelineHit>& hits);
+    void collect_hits(TargetKind kind, const char* format, std::vector<PipelineHit>& hits);
+
+    const GeneratorTable& table_;
+    EcGroupWalk walk_;
+    SearchBatch batch_;
+    PipelineStages stages_;
+    PubkeyMode mode_;
+    SimdBackend backend_;
+    U256 next_key_;
+    std::shared_ptr<const TargetSet> targets_;
+    bool default_stages_;
+    Kernel kernel_;
+    // الهدف الوحيد حين تكون المجموعة هدفًا واحدًا
+    unsigned char single_digest_[TARGET_DIGEST_MAX];
+    int single_id_ = -1;
+};
@@ -0,0 +1,367 @@
+#include "search_session.h"
+
+#include <algorithm>
+#include <cmath>
+
+// أقل عدد دفعات يُعتد بقياسه لسرعة العامل، وما دونه يغلب عليه التشويش
+static const uint64_t MIN_RATE_SAMPLE_BATCHES = 16;
+
+// ثابت زمن تنعيم السرعات المعروضة: التحديث كل إطار (~16 ms) يرى دفعات قليلة لكل عامل فيتذبذب دونه
+static const double RATE_SMOOTHING_SECONDS = 1.0;
+
+static CpuTopology unpinned_topology(size_t workers) {
+    CpuTopology topology;
+    if (workers == 0) workers = 1;
+    for (size_t i = 0; i < workers; ++i) topology.cores.push_back(CpuCore{-1, 0, (int)i, 1024, true});
+    return topology;
+}
+
+SearchSession::SearchSession(const CpuTopology& topology, std::function<void()> thread_enter,
+                             std::function<void()> thread_exit)
+    : thread_enter_(std::move(thread_enter)), thread_exit_(std::move(thread_exit)),
+      topology_(topology.cores.empty() ? unpinned_topology(1) : topology), rates_(topology_.cores.size(), 0.0) {
+    threads_.reserve(topology_.cores.size());
+    for (size_t i = 0; i < topology_.cores.size(); ++i) threads_.emplace_back(&SearchSession::worker_main, this, i);
+    reporter_ = std::thread(&SearchSession::reporter_main, this);
+}
+
+SearchSession::SearchSession(size_t workers, std::function<void()> thread_enter, std::function<void()> thread_exit)
+    : SearchSession(unpinned_topology(workers), std::move(thread_enter), std::move(thread_exit)) {}
+
+SearchSession::~SearchSession() {
+    stop(std::chrono::milliseconds(60000));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    cv_.notify_all();
+    reporter_cv_.notify_all();
+    for (std::thread& t : threads_) t.join();
+    reporter_.join();
+}
+
+bool SearchSession::start(const SearchJob& job, std::chrono::milliseconds stop_timeout) {
+    if (!stop(stop_timeout)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    search_ = std::make_shared<ActiveSearch>(job, threads_.size());
+    search_->active = threads_.size();
+    ++generation_;
+    state_ = SessionState::Running;
+    update_status([this](SearchStatus& status) {
+        status = SearchStatus{};
+        status.state = (uint32_t)SessionState::Running;
+        status.workers = (uint32_t)threads_.size();
+        status.search_id = (uint32_t)generation_;
+    });
+    cv_.notify_all();
+    reporter_cv_.notify_all();
+    return true;
+}
+
+void SearchSession::pause() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ != SessionState::Running) return;
+    // لا يكتب فوق إيقاف طلبه عامل وجد المفتاح
+    uint32_t expected = CONTROL_RUN;
+    search_->control.compare_exchange_strong(expected, CONTROL_PAUSE);
+    state_ = SessionState::Paused;
+    // المتوقف مؤقتًا قد يُقتل دون إيقاف
+    if (search_->job.checkpoint) search_->job.checkpoint->flush();
+    update_status([](SearchStatus& status) { status.state = (uint32_t)SessionState::Paused; });
+}
+
+void SearchSession::resume() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ != SessionState::Paused) return;
+    uint32_t expected = CONTROL_PAUSE;
+    search_->control.compare_exchange_strong(expected, CONTROL_RUN);
+    state_ = SessionState::Running;
+    update_status([](SearchStatus& status) { status.state = (uint32_t)SessionState::Running; });
+    control_cv_.notify_all();
+}
+
+bool SearchSession::stop(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!search_) return true;
+    state_ = SessionState::Stopping;
+    search_->control.store(CONTROL_STOP);
+    update_status([](SearchStatus& status) { status.state = (uint32_t)SessionState::Stopping; });
+    control_cv_.notify_all();
+    return cv_.wait_for(lock, timeout, [this] { return !search_; });
+}
+
+void SearchSession::request_stop(ActiveSearch& search) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    search.control.store(CONTROL_STOP);
+    control_cv_.notify_all();
+}
+
+bool SearchSession::batch_checkpoint(ActiveSearch& search) {
+    uint32_t control = search.control.load(std::memory_order_acquire);
+    if (control == CONTROL_RUN) return true;
+    if (control == CONTROL_STOP) return false;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    control_cv_.wait(lock, [&] { return search.control.load() != CONTROL_PAUSE; });
+    return search.control.load() != CONTROL_STOP;
+}
+
+std::vector<double> SearchSession::worker_weights(bool performance_only) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::vector<CpuCore>& cores = topology_.cores;
+
+    double per_capacity = 0;
+    size_t measured = 0;
+    for (size_t i = 0; i < cores.size(); ++i) {
+        if (rates_[i] > 0 && cores[i].capacity > 0) {
+            per_capacity += rates_[i] / cores[i].capacity;
+            ++measured;
+        }
+    }
+    if (measured > 0) per_capacity /= measured;
+
+    std::vector<double> weights(cores.size());
+    for (size_t i = 0; i < cores.size(); ++i) {
+        if (performance_only && !topology_.is_performance(cores[i])) weights[i] = 0;
+        else if (rates_[i] > 0) weights[i] = rates_[i];
+        else weights[i] = per_capacity > 0 ? cores[i].capacity * per_capacity : cores[i].capacity;
+    }
+    return weights;
+}
+
+SessionState SearchSession::state() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+void SearchSession::worker_main(size_t index) {
+    if (thread_enter_) thread_enter_();
+    cpu_pin_current_thread(topology_.cores[index].cpu);
+
+    uint64_t seen = 0;
+    WorkerPipeline worker;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        // search_ لا يُستبدل قبل أن ينهي كل العمال البحث الحالي، فلا يفوت أي عامل جيلًا
+        cv_.wait(lock, [&] { return shutdown_ || (search_ && generation_ != seen); });
+        if (shutdown_) break;
+        seen = generation_;
+        std::shared_ptr<ActiveSearch> search = search_;
+
+        lock.unlock();
+        run_search(*search, index, worker);
+        lock.lock();
+
+        if (--search->active == 0) {
+            lock.unlock();
+            {
+                // التحديث الأخير بالمجموع الكامل ومتوسط السرعة منذ البداية، ثم on_finished ولا تحديث بعدهما
+                std::lock_guard<std::mutex> report_lock(search->report_mutex);
+                search->finished = true;
+                std::vector<uint64_t> from_start(threads_.size(), 0);
+                double seconds =
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - search->started).count();
+                publish_progress(*search, from_start, seconds, 1.0);
+                // انتهى النطاق كله ما لم يُطلب الإيقاف (المفتاح 0 المتخطى لا يُعد)
+                bool exhausted = search->control.load() != CONTROL_STOP;
+                if (exhausted) update_status([](SearchStatus& status) { status.coverage = 1.0; });
+                if (search->job.checkpoint) {
+                    if (exhausted) search->job.checkpoint->remove();
+                    else search->job.checkpoint->flush();
+                }
+                search->job.listener->on_finished();
+            }
+            lock.lock();
+            search_.reset();
+            state_ = SessionState::Idle;
+            // تحت mutex_ حتى لا يكتب stop متأخر Stopping فوق Idle
+            update_status([](SearchStatus& status) { status.state = (uint32_t)SessionState::Idle; });
+            cv_.notify_all();
+            reporter_cv_.notify_all();
+        }
+    }
+    lock.unlock();
+
+    if (thread_exit_) thread_exit_();
+}
+
+void SearchSession::update_status(const std::function<void(SearchStatus&)>& change) {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    change(status_snapshot_);
+    status_.publish(status_snapshot_);
+}
+
+void SearchSession::publish_progress(ActiveSearch& search, std::vector<uint64_t>& last_keys, double seconds,
+                                     double smoothing) {
+    if (seconds <= 0) return;
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    SearchStatus& status = status_snapshot_;
+    uint64_t total = 0;
+    uint64_t delta = 0;
+    for (size_t i = 0; i < threads_.size(); ++i) {
+        uint64_t keys = search.counters[i].keys.load(std::memory_order_relaxed);
+        total += keys;
+        delta += keys - last_keys[i];
+        if (i < STATUS_MAX_WORKERS)
+            status.worker_rates[i] += smoothing * ((keys - last_keys[i]) / seconds - status.worker_rates[i]);
+        last_keys[i] = keys;
+    }
+    status.keys_checked = total;
+    status.keys_per_second += smoothing * (delta / seconds - status.keys_per_second);
+    // ما فحصته التشغيلات السابقة من نفس البحث جزء من التغطية، لا من عدد مفاتيح هذا التشغيل
+    double resumed = search.job.checkpoint ? u256_to_double(search.job.checkpoint->resumed_keys()) : 0;
+    status.coverage = std::min(1.0, (resumed + total) / search.job.scheduler->range_keys());
+    status_.publish(status);
+}
+
+void SearchSession::reporter_main() {
+    if (thread_enter_) thread_enter_();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        reporter_cv_.wait(lock, [&] { return shutdown_ || search_; });
+        if (shutdown_) break;
+        std::shared_ptr<ActiveSearch> search = search_;
+        const std::chrono::milliseconds interval =
+            search->job.progress_interval.count() > 0 ? search->job.progress_interval : std::chrono::milliseconds(1000);
+
+        std::vector<uint64_t> last_keys(threads_.size(), 0);
+        auto last_time = std::chrono::steady_clock::now();
+        while (!reporter_cv_.wait_for(lock, interval, [&] { return shutdown_ || search_ != search; })) {
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> report_lock(search->report_mutex);
+                if (!search->finished) {
+                    auto now = std::chrono::steady_clock::now();
+                    double seconds = std::chrono::duration<double>(now - last_time).count();
+                    last_time = now;
+                    publish_progress(*search, last_keys, seconds, 1.0 - std::exp(-seconds / RATE_SMOOTHING_SECONDS));
+                }
+            }
+            lock.lock();
+        }
+    }
+    lock.unlock();
+
+    if (thread_exit_) thread_exit_();
+}
+
+void SearchSession::run_search(ActiveSearch& search, size_t index, WorkerPipeline& worker) {
+    const SearchJob& job = search.job;
+    SearchListener& listener = *job.listener;
+    RangeScheduler& scheduler = *job.scheduler;
+    SearchCheckpoint* checkpoint = job.checkpoint.get();
+    if (index >= scheduler.workers()) return;
+
+    uint64_t keys_checked = 0;
+    std::atomic<uint64_t>& counter = search.counters[index].keys;
+    std::chrono::steady_clock::duration busy(0);    // زمن الدفعات فقط، دون الإيقاف المؤقت
+
+    // كل دفعة تمر بالمراحل: مفاتيح متتالية → نقاط (انعكاس مشترك) → hash160 متعدد المسارات → مطابقة
+    if (!worker.pipeline || worker.table != job.table || worker.group_size != job.group_size ||
+        worker.pubkey_mode != job.pubkey_mode) {
+        worker.pipeline.reset(new SearchPipeline(*job.table, job.group_size, job.pubkey_mode, job.targets,
+                                                 simd_best_backend()));
+        worker.table = job.table;
+        worker.group_size = job.group_size;
+        worker.pubkey_mode = job.pubkey_mode;
+    } else {
+        worker.pipeline->set_targets(job.targets);
+    }
+    SearchPipeline& pipeline = *worker.pipeline;
+    const size_t batch_size = pipeline.batch_size();
+    std::vector<PipelineHit> hits;
+    hits.reserve(4);
+
+    // موضع المشي بعد آخر دفعة: القطعة التالية من نفس الشريحة تبدأ منه فلا تحتاج ضربًا كاملًا
+    U256 walk_next = {};
+    bool walk_valid = false;
+
+    // الشريحة من الجدولة مواضع في ترتيب الزيارة، وكل قطعة تُتخطى أو تُستأنف أو تُفحص وحدها
+    // لأجل نقطة الاستئناف. في الترتيب الخطي القطع المتتالية تكمل نفس المشي دون ضرب جديد
+    ChunkSpan span;
+    bool running = true;
+    while (running && batch_checkpoint(search) && scheduler.next_span(index, span)) {
+        for (uint64_t p = span.first; running && p < span.first + span.count; ++p) {
+            const uint64_t c = scheduler.chunk_at(p);
+            KeyChunk chunk = scheduler.chunk(c);
+            U256 base = chunk.first;
+            if (checkpoint != nullptr) {
+                if (checkpoint->chunk_done(c)) continue;
+                base = checkpoint->resume_point(c, base);
+            }
+            // المفتاح 0 ليس مفتاحًا خاصًا صالحًا
+            if (u256_is_zero(base)) base = u256_from_u64(1);
+            if (u256_cmp(base, chunk.last) > 0) continue;
+            if (!walk_valid || u256_cmp(walk_next, base) != 0) pipeline.reset(base);
+
+            // المقطع: إزاحة 64-بت من base، فالدفعات تزيد كلمة أصلية واحدة والحمل إلى 256 بت عند حدود
+            // المقطع فقط. القطعة الأطول من 2^64 مفتاحًا (في النطاقات الهائلة) تُمشى مقاطع متتالية
+            bool chunk_finished = false;
+            while (running && !chunk_finished) {
+                U256 rest;
+                u256_sub(rest, chunk.last, base);
+                const bool last_leg = u256_fits_u64(rest);
+                const uint64_t last_offset = last_leg ? rest.d[0] : UINT64_MAX;
+                if (checkpoint != nullptr) checkpoint->begin_cursor(index, base);
+
+                uint64_t offset = 0;
+                for (;;) {
+                    // نقطة التحكم الوحيدة: قراءة ذرية واحدة لكل دفعة
+                    if (!batch_checkpoint(search)) {
+                        running = false;
+                        break;
+                    }
+
+                    size_t n = (size_t)std::min<uint64_t>(batch_size - 1, last_offset - offset) + 1;
+                    auto batch_start = std::chrono::steady_clock::now();
+                    bool found = pipeline.run_batch(n, hits);
+                    busy += std::chrono::steady_clock::now() - batch_start;
+                    for (size_t h = 0; found && h < hits.size(); ++h) {
+                        U256 key;
+                        u256_add_u64(key, base, offset + hits[h].index);
+                        update_status([&key](SearchStatus& status) {
+                            ++status.hit_count;
+                            status.found_key = key;
+                        });
+                        listener.on_key_found(key, hits[h].format, hits[h].target);
+                        const size_t target = hits[h].target;
+                        const uint64_t bit = 1ull << (target % 64);
+                        if ((search.found[target / 64].fetch_or(bit) & bit) == 0 &&
+                            search.found_targets.fetch_add(1) + 1 >= job.targets->size()) {
+                            request_stop(search);
+                        }
+                    }
+
+                    keys_checked += n;
+                    counter.store(keys_checked, std::memory_order_relaxed);
+
+                    if (last_offset - offset < n) break;
+                    offset += n;
+                    if (checkpoint != nullptr) checkpoint->set_cursor(index, offset);
+                }
+                if (!running) break;
+
+                // المشي سبق إلى بعد آخر دفعة كاملة بـ batch_size
+                walk_valid = u256_add_u64(walk_next, base, offset) == 0 &&
+                             u256_add_u64(walk_next, walk_next, batch_size) == 0;
+                if (last_leg) {
+                    chunk_finished = true;
+                    if (checkpoint != nullptr) checkpoint->mark_done(c);
+                } else {
+                    u256_add_u64(base, base, last_offset);
+                    u256_add_u64(base, base, 1);
+                }
+            }
+        }
+    }
+
+    // سرعة هذا العامل على نواته تزن حصته في البحث التالي
+    double seconds = std::chrono::duration<double>(busy).count();
+    if (keys_checked >= MIN_RATE_SAMPLE_BATCHES * batch_size && seconds > 0) {
+        double rate = keys_checked / seconds;
+        std::lock_guard<std::mutex> lock(mutex_);
+        rates_[index] = rates_[index] > 0 ? (rates_[index] + rate) / 2 : rate;
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+// جلسة بحث أصلية طويلة العمر: خيوط العمل تُنشأ مرة واحدة وتنتظر على condition variable
+// بين عمليات البحث، فبدء بحث جديد لا يكلف إنشاء خيوط ولا ربطها بـ JVM.
+// كل بحث له حالة خاصة به (إيقاف، إيقاف مؤقت، عدد العمال النشطين) بدل أعلام عامة،
+// فلا يختلط عمال بحث قديم ببحث جديد.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cpu_topology.h"
+#include "gen_table.h"
+#include "range_scheduler.h"
+#include "search_checkpoint.h"
+#include "search_pipeline.h"
+#include "status_block.h"
+
+// الأحداث النادرة فقط: on_key_found من العامل الذي وجد المفتاح (target رقم الهدف بترتيب إدخاله)،
+// و on_finished مرة واحدة لكل بحث
+// بعد آخر تحديث لكتلة الحالة. التقدم لا يمر من هنا بل من status() التي يقرؤها التطبيق بنفسه.
+class SearchListener {
+public:
+    virtual ~SearchListener() {}
+    virtual void on_key_found(const U256& key, const char* format, size_t target) = 0;
+    virtual void on_finished() = 0;
+};
+
+struct SearchJob {
+    std::shared_ptr<RangeScheduler> scheduler;      // بعدد عمال الجلسة
+    std::shared_ptr<const GeneratorTable> table;
+    // البحث يتوقف حين يُعثر على مفتاح كل الأهداف أو ينتهي النطاق
+    std::shared_ptr<const TargetSet> targets;
+    PubkeyMode pubkey_mode;
+    size_t group_size;
+    std::chrono::milliseconds progress_interval;    // الفاصل بين تحديثات التقدم في كتلة الحالة
+    std::shared_ptr<SearchListener> listener;       // يُحرر بعد on_finished وخروج آخر عامل
+    // اختيارية: بقطع scheduler نفسها. تُتخطى القطع المكتملة، ويُحذف الملف إن اكتمل النطاق
+    std::shared_ptr<SearchCheckpoint> checkpoint;
+};
+
+enum class SessionState { Idle, Running, Paused, Stopping };
+
+class SearchSession {
+public:
+    // عامل لكل نواة في topology بنفس ترتيبها، مثبت على معالجها.
+    // thread_enter / thread_exit تُنفذ داخل كل خيط عمل وخيط التقارير عند إنشائه وقبل خروجه (ربط JVM مثلًا)
+    SearchSession(const CpuTopology& topology, std::function<void()> thread_enter, std::function<void()> thread_exit);
+    // workers عاملًا متساويًا دون تثبيت
+    SearchSession(size_t workers, std::function<void()> thread_enter, std::function<void()> thread_exit);
+    ~SearchSession();
+
+    // أوزان RangeScheduler لكل عامل: سرعته المقاسة في عمليات البحث السابقة (مفاتيح/ث)،
+    // أو سعة نواته مضروبة في سرعة وحدة السعة المقاسة عند غيرها إن لم يُقس بعد.
+    // performance_only يعطي أنوية LITTLE وزن 0 فلا تشارك.
+    std::vector<double> worker_weights(bool performance_only);
+
+    // Idle → Running. يوقف البحث السابق أولًا، ويعيد false إن لم يهدأ خلال stop_timeout
+    bool start(const SearchJob& job, std::chrono::milliseconds stop_timeout);
+    // Running → Paused
+    void pause();
+    // Paused → Running
+    void resume();
+    // Running / Paused → Stopping → Idle. ينتظر حتى timeout، ويعيد true إن خرج كل العمال.
+    // العمال يفحصون التحكم بين الدفعات فقط، فزمن الإيقاف لا يتجاوز دفعة واحدة لكل عامل
+    // (group_size مفتاح: ~1 ms على نواة كبيرة و~10 ms على LITTLE عند 1024)، والمتوقف مؤقتًا يستيقظ فورًا.
+    // يقيسه app/src/test/cpp/search_session_test.cpp
+    bool stop(std::chrono::milliseconds timeout);
+
+    SessionState state();
+    size_t workers() const { return threads_.size(); }
+
+    // كتلة الحالة المشتركة: عنوانها ثابت طوال عمر الجلسة، فيُعرض مرة واحدة كـ ByteBuffer مباشر.
+    // تُحدّث عند تغير الحالة، وعند العثور على مفتاح، ومن خيط التقارير كل progress_interval
+    StatusBlock& status() { return status_; }
+
+private:
+    // أمر التحكم لبحث واحد: يُقرأ مرة لكل دفعة، ويُكتب تحت mutex_ مع إشعار control_cv_
+    enum Control : uint32_t { CONTROL_RUN = 0, CONTROL_PAUSE = 1, CONTROL_STOP = 2 };
+
+    // عداد كل عامل في سطر كاش خاص به: كاتب واحد، فيكفي store عادي دون fetch_add،
+    // ولا يتشارك عاملان سطرًا فلا يرتد السطر بين الأنوية
+    struct alignas(64) WorkerCounter {
+        std::atomic<uint64_t> keys{0};
+    };
+
+    struct ActiveSearch {
+        ActiveSearch(const SearchJob& new_job, size_t workers)
+            : job(new_job), found(new std::atomic<uint64_t>[(new_job.targets->id_limit() + 63) / 64]()),
+              counters(new WorkerCounter[workers]) {}
+        SearchJob job;
+        std::atomic<uint32_t> control{CONTROL_RUN};
+        // بت لكل رقم هدف عُثر على مفتاحه، وعدد الأهداف المختلفة فيه: المفتاح المكرر (قطعة جزئية
+        // يُعاد مشيها بعد الاستئناف مثلًا) لا يُحسب مرتين فلا يوقف البحث قبل إيجاد كل الأهداف
+        std::unique_ptr<std::atomic<uint64_t>[]> found;
+        std::atomic<size_t> found_targets{0};
+        std::unique_ptr<WorkerCounter[]> counters;
+        std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+        size_t active = 0;          // تحت mutex_ الجلسة
+
+        // يرتب تقارير خيط التقارير مع التقرير الأخير و on_finished
+        std::mutex report_mutex;
+        bool finished = false;      // تحت report_mutex
+    };
+
+    // خط المعالجة الخاص بكل عامل، يبقى بين عمليات البحث ما دام الجدول والحجم والصيغة كما هي
+    struct WorkerPipeline {
+        std::unique_ptr<SearchPipeline> pipeline;
+        std::shared_ptr<const GeneratorTable> table;
+        size_t group_size = 0;
+        PubkeyMode pubkey_mode = PubkeyMode::Compressed;
+    };
+
+    // بين الدفعات: يعيد false إن طُلب الإيقاف، والعامل المتوقف مؤقتًا ينام على control_cv_
+    bool batch_checkpoint(ActiveSearch& search);
+    void request_stop(ActiveSearch& search);
+
+    // يعدّل نسخة الكاتب من الحالة وينشرها، والكتّاب مسلسلون بـ status_mutex_
+    void update_status(const std::function<void(SearchStatus&)>& change);
+    // يجمع عدادات العمال منذ last_keys وينشرها. السرعات تقترب من سرعة الفترة بنسبة smoothing (1: دون تنعيم)
+    void publish_progress(ActiveSearch& search, std::vector<uint64_t>& last_keys, double seconds, double smoothing);
+
+    void worker_main(size_t index);
+    void reporter_main();
+    void run_search(ActiveSearch& search, size_t index, WorkerPipeline& worker);
+
+    std::mutex mutex_;
+    std::condition_variable cv_;            // العمال ينتظرون بحثًا جديدًا، و stop ينتظر عودة الحالة إلى Idle
+    std::condition_variable control_cv_;    // العمال المتوقفون مؤقتًا ينتظرون الاستئناف أو الإيقاف
+    std::condition_variable reporter_cv_;   // خيط التقارير ينتظر بحثًا جديدًا أو موعد التحديث التالي
+    SessionState state_ = SessionState::Idle;
+    std::shared_ptr<ActiveSearch> search_;
+    uint64_t generation_ = 0;
+    bool shutdown_ = false;
+    std::function<void()> thread_enter_;
+    std::function<void()> thread_exit_;
+    CpuTopology topology_;
+    std::vector<double> rates_;     // مفاتيح/ث لكل عامل، 0 = لم يُقس بعد (تحت mutex_)
+    std::vector<std::thread> threads_;
+    std::thread reporter_;
+
+    std::mutex status_mutex_;       // بعد mutex_ و report_mutex في ترتيب الأقفال
+    SearchStatus status_snapshot_ = {};
+    StatusBlock status_;
+};
@@ -0,0 +1,343 @@
+#include "secp256k1.h"
+
+// p = 2^256 - C، لذلك 2^256 ≡ C (mod p)
+static const uint64_t FIELD_C = 0x1000003D1ULL;
+static const FieldElem FIELD_P = {{0xFFFFFFFEFFFFFC2FULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL,
+                                   0xFFFFFFFFFFFFFFFFULL}};
+
+const AffinePoint SECP256K1_G = {
+    {{0x59F2815B16F81798ULL, 0x029BFCDB2DCE28D9ULL, 0x55A06295CE870B07ULL, 0x79BE667EF9DCBBACULL}},
+    {{0x9C47D08FFB10D4B8ULL, 0xFD17B448A6855419ULL, 0x5DA4FBFC0E1108A8ULL, 0x483ADA7726A3C465ULL}},
+    false};
+
+const U256 SECP256K1_N = {
+    {0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL}};
+
+// يطرح p مرة واحدة إن كانت القيمة >= p أو كان هناك محمول من 2^256
+static inline void fe_normalize(FieldElem& r, uint64_t carry) {
+    uint64_t borrow = 0;
+    uint64_t t[4];
+    for (int i = 0; i < 4; ++i) t[i] = subb64(r.n[i], FIELD_P.n[i], borrow, &borrow);
+    if (carry || !borrow) {
+        for (int i = 0; i < 4; ++i) r.n[i] = t[i];
+    }
+}
+
+void fe_set_u256(FieldElem& r, const U256& a) {
+    for (int i = 0; i < 4; ++i) r.n[i] = a.d[i];
+    fe_normalize(r, 0);
+}
+
+void fe_add(FieldElem& r, const FieldElem& a, const FieldElem& b) {
+    uint64_t c = 0;
+    for (int i = 0; i < 4; ++i) r.n[i] = addc64(a.n[i], b.n[i], c, &c);
+    fe_normalize(r, c);
+}
+
+void fe_sub(FieldElem& r, const FieldElem& a, const FieldElem& b) {
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i) r.n[i] = subb64(a.n[i], b.n[i], borrow, &borrow);
+    if (borrow) {
+        uint64_t c = 0;
+        for (int i = 0; i < 4; ++i) r.n[i] = addc64(r.n[i], FIELD_P.n[i], c, &c);
+    }
+}
+
+void fe_neg(FieldElem& r, const FieldElem& a) {
+    static const FieldElem zero = {{0, 0, 0, 0}};
+    fe_sub(r, zero, a);
+}
+
+// اختزال ناتج 512 بت: t_lo + t_hi * C ثم اختزال المحمول الصغير مرة أخرى
+static inline void fe_reduce512(FieldElem& r, const uint64_t t[8]) {
+    uint64_t m[5];
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        uint64_t hi;
+        uint64_t lo = mul64(t[4 + i], FIELD_C, &hi);
+        uint64_t c;
+        m[i] = addc64(lo, carry, 0, &c);
+        carry = hi + c;
+    }
+    m[4] = carry;
+
+    uint64_t c = 0;
+    for (int i = 0; i < 4; ++i) r.n[i] = addc64(t[i], m[i], c, &c);
+    uint64_t top = m[4] + c;
+
+    uint64_t hi;
+    uint64_t lo = mul64(top, FIELD_C, &hi);
+    r.n[0] = addc64(r.n[0], lo, 0, &c);
+    r.n[1] = addc64(r.n[1], hi, c, &c);
+    r.n[2] = addc64(r.n[2], 0, c, &c);
+    r.n[3] = addc64(r.n[3], 0, c, &c);
+    // محمول جديد هنا يعني أن القيمة تجاوزت 2^256 بقليل، ويكفي إضافة C مرة أخيرة
+    if (c) {
+        r.n[0] = addc64(r.n[0], FIELD_C, 0, &c);
+        r.n[1] = addc64(r.n[1], 0, c, &c);
+        r.n[2] = addc64(r.n[2], 0, c, &c);
+        r.n[3] = addc64(r.n[3], 0, c, &c);
+    }
+    fe_normalize(r, 0);
+}
+
+void fe_mul(FieldElem& r, const FieldElem& a, const FieldElem& b) {
+    uint64_t t[8];
+    uint64_t c0 = 0, c1 = 0, c2 = 0;
+    for (int k = 0; k < 7; ++k) {
+        int i_min = k < 4 ? 0 : k - 3;
+        int i_max = k < 4 ? k : 3;
+        for (int i = i_min; i <= i_max; ++i) {
+            uint64_t hi, c;
+            uint64_t lo = mul64(a.n[i], b.n[k - i], &hi);
+            c0 = addc64(c0, lo, 0, &c);
+            c1 = addc64(c1, hi, c, &c);
+            c2 += c;
+        }
+        t[k] = c0;
+        c0 = c1;
+        c1 = c2;
+        c2 = 0;
+    }
+    t[7] = c0;
+    fe_reduce512(r, t);
+}
+
+void fe_sqr(FieldElem& r, const FieldElem& a) {
+    fe_mul(r, a, a);
+}
+
+static inline void fe_sqr_n(FieldElem& r, const FieldElem& a, int n) {
+    r = a;
+    for (int i = 0; i < n; ++i) fe_sqr(r, r);
+}
+
+// a^(p-2) بسلسلة الجمع المعروفة لـ secp256k1 (255 تربيع و 15 ضرب)
+void fe_inv(FieldElem& r, const FieldElem& a) {
+    FieldElem x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t;
+
+    fe_sqr(x2, a);
+    fe_mul(x2, x2, a);
+    fe_sqr(x3, x2);
+    fe_mul(x3, x3, a);
+    fe_sqr_n(x6, x3, 3);
+    fe_mul(x6, x6, x3);
+    fe_sqr_n(x9, x6, 3);
+    fe_mul(x9, x9, x3);
+    fe_sqr_n(x11, x9, 2);
+    fe_mul(x11, x11, x2);
+    fe_sqr_n(x22, x11, 11);
+    fe_mul(x22, x22, x11);
+    fe_sqr_n(x44, x22, 22);
+    fe_mul(x44, x44, x22);
+    fe_sqr_n(x88, x44, 44);
+    fe_mul(x88, x88, x44);
+    fe_sqr_n(x176, x88, 88);
+    fe_mul(x176, x176, x88);
+    fe_sqr_n(x220, x176, 44);
+    fe_mul(x220, x220, x44);
+    fe_sqr_n(x223, x220, 3);
+    fe_mul(x223, x223, x3);
+
+    fe_sqr_n(t, x223, 23);
+    fe_mul(t, t, x22);
+    fe_sqr_n(t, t, 5);
+    fe_mul(t, t, a);
+    fe_sqr_n(t, t, 3);
+    fe_mul(t, t, x2);
+    fe_sqr_n(t, t, 2);
+    fe_mul(r, t, a);
+}
+
+// a^((p+1)/4): الجذر التربيعي لأن p ≡ 3 (mod 4). نفس سلسلة fe_inv حتى x223 ثم ذيل (p+1)/4
+bool fe_sqrt(FieldElem& r, const FieldElem& a) {
+    FieldElem x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t;
+
+    fe_sqr(x2, a);
+    fe_mul(x2, x2, a);
+    fe_sqr(x3, x2);
+    fe_mul(x3, x3, a);
+    fe_sqr_n(x6, x3, 3);
+    fe_mul(x6, x6, x3);
+    fe_sqr_n(x9, x6, 3);
+    fe_mul(x9, x9, x3);
+    fe_sqr_n(x11, x9, 2);
+    fe_mul(x11, x11, x2);
+    fe_sqr_n(x22, x11, 11);
+    fe_mul(x22, x22, x11);
+    fe_sqr_n(x44, x22, 22);
+    fe_mul(x44, x44, x22);
+    fe_sqr_n(x88, x44, 44);
+    fe_mul(x88, x88, x44);
+    fe_sqr_n(x176, x88, 88);
+    fe_mul(x176, x176, x88);
+    fe_sqr_n(x220, x176, 44);
+    fe_mul(x220, x220, x44);
+    fe_sqr_n(x223, x220, 3);
+    fe_mul(x223, x223, x3);
+
+    fe_sqr_n(t, x223, 23);
+    fe_mul(t, t, x22);
+    fe_sqr_n(t, t, 6);
+    fe_mul(t, t, x2);
+    fe_sqr_n(r, t, 2);
+
+    fe_sqr(t, r);
+    return fe_equal(t, a);
+}
+
+void fe_to_be_bytes(const FieldElem& a, unsigned char out[32]) {
+    U256 v = {{a.n[0], a.n[1], a.n[2], a.n[3]}};
+    u256_to_be_bytes(v, out);
+}
+
+void ec_jacobian_double(JacobianPoint& r, const JacobianPoint& a) {
+    if (a.infinity || fe_is_zero(a.y)) {
+        r.infinity = true;
+        return;
+    }
+    FieldElem yy, s, m, t, x3, y3, z3;
+    fe_sqr(yy, a.y);
+    fe_mul(s, a.x, yy);
+    fe_add(s, s, s);
+    fe_add(s, s, s);           // S = 4*X*Y^2
+    fe_sqr(m, a.x);
+    fe_add(t, m, m);
+    fe_add(m, t, m);           // M = 3*X^2
+    fe_sqr(x3, m);
+    fe_sub(x3, x3, s);
+    fe_sub(x3, x3, s);         // X3 = M^2 - 2S
+    fe_sqr(t, yy);
+    fe_add(t, t, t);
+    fe_add(t, t, t);
+    fe_add(t, t, t);           // 8*Y^4
+    fe_sub(y3, s, x3);
+    fe_mul(y3, y3, m);
+    fe_sub(y3, y3, t);         // Y3 = M*(S - X3) - 8*Y^4
+    fe_mul(z3, a.y, a.z);
+    fe_add(z3, z3, z3);        // Z3 = 2*Y*Z
+    r.x = x3;
+    r.y = y3;
+    r.z = z3;
+    r.infinity = false;
+}
+
+void ec_jacobian_add_affine(JacobianPoint& r, const JacobianPoint& a, const AffinePoint& b) {
+    if (b.infinity) {
+        r = a;
+        return;
+    }
+    if (a.infinity) {
+        r.x = b.x;
+        r.y = b.y;
+        r.z = {{1, 0, 0, 0}};
+        r.infinity = false;
+        return;
+    }
+    FieldElem z1z1, u2, s2, h, rr, hh, hhh, v, t, x3, y3, z3;
+    fe_sqr(z1z1, a.z);
+    fe_mul(u2, b.x, z1z1);
+    fe_mul(s2, b.y, a.z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, a.x);
+    fe_sub(rr, s2, a.y);
+    if (fe_is_zero(h)) {
+        if (fe_is_zero(rr)) {
+            ec_jacobian_double(r, a);
+        } else {
+            r.infinity = true;
+        }
+        return;
+    }
+    fe_sqr(hh, h);
+    fe_mul(hhh, h, hh);
+    fe_mul(v, a.x, hh);
+    fe_sqr(x3, rr);
+    fe_sub(x3, x3, hhh);
+    fe_sub(x3, x3, v);
+    fe_sub(x3, x3, v);         // X3 = r^2 - H^3 - 2V
+    fe_sub(y3, v, x3);
+    fe_mul(y3, y3, rr);
+    fe_mul(t, a.y, hhh);
+    fe_sub(y3, y3, t);         // Y3 = r*(V - X3) - Y1*H^3
+    fe_mul(z3, a.z, h);        // Z3 = Z1*H
+    r.x = x3;
+    r.y = y3;
+    r.z = z3;
+    r.infinity = false;
+}
+
+void ec_jacobian_to_affine(AffinePoint& r, const JacobianPoint& a) {
+    if (a.infinity) {
+        r.infinity = true;
+        return;
+    }
+    FieldElem zinv, zinv2;
+    fe_inv(zinv, a.z);
+    fe_sqr(zinv2, zinv);
+    fe_mul(r.x, a.x, zinv2);
+    fe_mul(zinv2, zinv2, zinv);
+    fe_mul(r.y, a.y, zinv2);
+    r.infinity = false;
+}
+
+void ec_affine_add(AffinePoint& r, const AffinePoint& a, const AffinePoint& b) {
+    if (a.infinity) {
+        r = b;
+        return;
+    }
+    if (b.infinity) {
+        r = a;
+        return;
+    }
+    FieldElem dx, dy, lambda, t, x3, y3;
+    fe_sub(dx, b.x, a.x);
+    fe_sub(dy, b.y, a.y);
+    if (fe_is_zero(dx)) {
+        if (!fe_is_zero(dy)) {
+            r.infinity = true;
+            return;
+        }
+        // P + P: ميل المماس 3x^2 / 2y
+        if (fe_is_zero(a.y)) {
+            r.infinity = true;
+            return;
+        }
+        fe_sqr(t, a.x);
+        fe_add(dy, t, t);
+        fe_add(dy, dy, t);
+        fe_add(dx, a.y, a.y);
+    }
+    fe_inv(t, dx);
+    fe_mul(lambda, dy, t);
+    fe_sqr(x3, lambda);
+    fe_sub(x3, x3, a.x);
+    fe_sub(x3, x3, b.x);       // x3 = λ^2 - x1 - x2
+    fe_sub(y3, a.x, x3);
+    fe_mul(y3, y3, lambda);
+    fe_sub(y3, y3, a.y);       // y3 = λ(x1 - x3) - y1
+    r.x = x3;
+    r.y = y3;
+    r.infinity = false;
+}
+
+void ec_mul_generator(AffinePoint& r, const U256& k) {
+    JacobianPoint acc;
+    acc.infinity = true;
+    for (int bit = 255; bit >= 0; --bit) {
+        ec_jacobian_double(acc, acc);
+        if (u256_bit(k, bit)) ec_jacobian_add_affine(acc, acc, SECP256K1_G);
+    }
+    ec_jacobian_to_affine(r, acc);
+}
+
+void ec_serialize_compressed(const AffinePoint& p, unsigned char out[33]) {
+    out[0] = fe_is_odd(p.y) ? 0x03 : 0x02;
+    fe_to_be_bytes(p.x, out + 1);
+}
+
+void ec_serialize_uncompressed(const AffinePoint& p, unsigned char out[65]) {
+    out[0] = 0x04;
+    fe_to_be_bytes(p.x, out + 1);
+    fe_to_be_bytes(p.y, out + 33);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// محرك secp256k1 داخلي للبحث: حساب الحقل modulo p، وجمع النقاط، والضرب في G.
+// البحث يحسب k*G مرة واحدة لبداية كل مقطع ثم يمشي بالجمع P(k+1) = P(k) + G.
+
+#include "uint256.h"
+
+// عنصر في الحقل modulo p = 2^256 - 2^32 - 977، مختزل دائمًا (أقل من p)
+struct FieldElem {
+    uint64_t n[4];
+};
+
+struct AffinePoint {
+    FieldElem x;
+    FieldElem y;
+    bool infinity;
+};
+
+struct JacobianPoint {
+    FieldElem x;
+    FieldElem y;
+    FieldElem z;
+    bool infinity;
+};
+
+extern const AffinePoint SECP256K1_G;
+extern const U256 SECP256K1_N;
+
+void fe_set_u256(FieldElem& r, const U256& a);
+void fe_add(FieldElem& r, const FieldElem& a, const FieldElem& b);
+void fe_sub(FieldElem& r, const FieldElem& a, const FieldElem& b);
+void fe_neg(FieldElem& r, const FieldElem& a);
+void fe_mul(FieldElem& r, const FieldElem& a, const FieldElem& b);
+void fe_sqr(FieldElem& r, const FieldElem& a);
+void fe_inv(FieldElem& r, const FieldElem& a);
+// r² = a إن كان a مربعًا، ويعيد false إن لم يكن
+bool fe_sqrt(FieldElem& r, const FieldElem& a);
+
+static inline bool fe_equal(const FieldElem& a, const FieldElem& b) {
+    return ((a.n[0] ^ b.n[0]) | (a.n[1] ^ b.n[1]) | (a.n[2] ^ b.n[2]) | (a.n[3] ^ b.n[3])) == 0;
+}
+
+static inline bool fe_is_zero(const FieldElem& a) {
+    return (a.n[0] | a.n[1] | a.n[2] | a.n[3]) == 0;
+}
+
+static inline bool fe_is_odd(const FieldElem& a) {
+    return a.n[0] & 1;
+}
+
+void fe_to_be_bytes(const FieldElem& a, unsigned char out[32]);
+
+void ec_jacobian_double(JacobianPoint& r, const JacobianPoint& a);
+void ec_jacobian_add_affine(JacobianPoint& r, const JacobianPoint& a, const AffinePoint& b);
+void ec_jacobian_to_affine(AffinePoint& r, const JacobianPoint& a);
+
+// جمع نقطتين affine بانعكاس واحد في الحقل، مع حالات التساوي واللانهاية
+void ec_affine_add(AffinePoint& r, const AffinePoint& a, const AffinePoint& b);
+
+// k*G بطريقة double-and-add، لا يُستعمل في الحلقة الساخنة
+void ec_mul_generator(AffinePoint& r, const U256& k);
+
+void ec_serialize_compressed(const AffinePoint& p, unsigned char out[33]);
+void ec_serialize_uncompressed(const AffinePoint& p, unsigned char out[65]);
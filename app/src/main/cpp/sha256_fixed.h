@@ -0,0 +1,122 @@
+#pragma once
+
+// SHA-256 مخصص وقت الترجمة لطول رسالة ثابت (32 و 33 و 65 بايت في البحث).
+// كلمات الحشو والطول معروفة مسبقًا فتصبح ثوابت في جدول الرسالة وتُطوى مع K،
+// ولا يوجد init/update/final ولا نسخ إلى مخزن وسيط كما في SHA256() من OpenSSL.
+// PREFIX: بايتات سابقة بعدد كتل كامل مضغوطة مسبقًا في حالة وسيطة (midstate)،
+// تدخل في حقل الطول فقط.
+
+#include "hash_mb_internal.h"
+#include "sha256_mb_kernel.h"
+
+template <size_t LEN, size_t PREFIX = 0>
+struct Sha256FixedShape {
+    static_assert(LEN <= SHA256_MB_MAX_LEN, "message does not fit in two SHA-256 blocks");
+    static_assert(PREFIX % 64 == 0, "prefix must be whole blocks");
+    static constexpr size_t BLOCKS = (LEN + 9 + 63) / 64;
+
+    // قيمة بايت الحشو في الموضع pos (0 لبايتات البيانات)
+    static constexpr uint32_t pad_byte(size_t pos) {
+        if (pos < LEN) return 0;
+        if (pos == LEN) return 0x80;
+        if (pos >= BLOCKS * 64 - 8) {
+            const uint64_t bits = (uint64_t)(PREFIX + LEN) * 8;
+            return (uint32_t)(bits >> (8 * (BLOCKS * 64 - 1 - pos))) & 0xFF;
+        }
+        return 0;
+    }
+
+    static constexpr uint32_t pad_word(size_t blk, int i) {
+        const size_t off = blk * 64 + (size_t)i * 4;
+        return (pad_byte(off) << 24) | (pad_byte(off + 1) << 16) | (pad_byte(off + 2) << 8) | pad_byte(off + 3);
+    }
+
+    // عدد بايتات البيانات داخل الكلمة (0 = ثابتة بالكامل، 4 = بيانات بالكامل)
+    static constexpr size_t data_bytes(size_t blk, int i) {
+        const size_t off = blk * 64 + (size_t)i * 4;
+        return off >= LEN ? 0 : (LEN - off >= 4 ? 4 : LEN - off);
+    }
+};
+
+template <class V, size_t LEN, size_t PREFIX, size_t BLK, int I>
+static inline V sha256_fixed_word(const unsigned char* const* msgs) {
+    typedef Sha256FixedShape<LEN, PREFIX> Shape;
+    constexpr size_t n = Shape::data_bytes(BLK, I);
+    constexpr uint32_t pad = Shape::pad_word(BLK, I);
+    if constexpr (n == 0) {
+        return V::set1(pad);
+    } else {
+        const int L = V::LANES;
+        constexpr size_t off = BLK * 64 + (size_t)I * 4;
+        uint32_t lanes[L];
+        for (int l = 0; l < L; ++l) {
+            if constexpr (n == 4) {
+                lanes[l] = load_be32(msgs[l] + off);
+            } else {
+                uint32_t word = 0;
+                for (size_t j = 0; j < n; ++j) word |= (uint32_t)msgs[l][off + j] << (24 - 8 * j);
+                lanes[l] = word | pad;
+            }
+        }
+        return V::load(lanes);
+    }
+}
+
+template <class V, size_t LEN, size_t PREFIX, size_t BLK, int... I>
+static inline void sha256_fixed_block(const unsigned char* const* msgs, V s[8], std::integer_sequence<int, I...>) {
+    V w[64];
+    ((w[I] = sha256_fixed_word<V, LEN, PREFIX, BLK, I>(msgs)), ...);
+    sha256_mb_compress(s, w);
+}
+
+// يكمل التجزئة من الحالة الوسيطة midstate بعد PREFIX بايت مشتركة بين كل الرسائل
+template <class V, size_t LEN, size_t PREFIX>
+static inline void sha256_mb_hash_fixed_from(const unsigned char* const* msgs, const uint32_t midstate[8], V s[8]) {
+    for (int i = 0; i < 8; ++i) s[i] = V::set1(midstate[i]);
+    sha256_fixed_block<V, LEN, PREFIX, 0>(msgs, s, std::make_integer_sequence<int, 16>());
+    if constexpr (Sha256FixedShape<LEN, PREFIX>::BLOCKS > 1) {
+        sha256_fixed_block<V, LEN, PREFIX, 1>(msgs, s, std::make_integer_sequence<int, 16>());
+    }
+}
+
+// مثل sha256_mb_hash لكن بطول ثابت: تُقرأ الرسائل مباشرة بلا مخزن حشو لكل مسار
+template <class V, size_t LEN>
+static inline void sha256_mb_hash_fixed(const unsigned char* const* msgs, V s[8]) {
+    sha256_mb_hash_fixed_from<V, LEN, 0>(msgs, SHA256_IV, s);
+}
+
+// الأطوال التي يستعملها البحث تذهب للنسخة المخصصة، وغيرها للنسخة العامة
+template <class V>
+static inline void sha256_mb_hash_any(const unsigned char* const* msgs, size_t len, V s[8]) {
+    switch (len) {
+        case 32: sha256_mb_hash_fixed<V, 32>(msgs, s); break;
+        case 33: sha256_mb_hash_fixed<V, 33>(msgs, s); break;
+        case 65: sha256_mb_hash_fixed<V, 65>(msgs, s); break;
+        default: sha256_mb_hash(msgs, len, s); break;
+    }
+}
+
+// نقطة الدخول لكل معمارية: تعالج بالضبط V::LANES رسالة
+template <class V>
+static void sha256_mb_lanes(const unsigned char* const* msgs, size_t len, unsigned char (*digests)[32]) {
+    V s[8];
+    sha256_mb_hash_any(msgs, len, s);
+    sha256_mb_store(s, digests);
+}
+
+// رسالة واحدة بطول LEN، بديل مباشر لـ SHA256(msg, LEN, out)
+template <size_t LEN>
+static inline void sha256_fixed(const unsigned char* msg, unsigned char out[32]) {
+    const unsigned char* msgs[1] = {msg};
+    VecScalar s[8];
+    sha256_mb_hash_fixed<VecScalar, LEN>(msgs, s);
+    sha256_mb_store(s, (unsigned char (*)[32])out);
+}
+
+// tagged_hash("TapTweak", x) لـ V::LANES إحداثيات x-only بطول 32 بايت
+template <class V>
+static void tap_tweak_mb_lanes(const unsigned char* const* xs, unsigned char (*tweaks)[32]) {
+    V s[8];
+    sha256_mb_hash_fixed_from<V, 32, 64>(xs, tap_tweak_midstate(), s);
+    sha256_mb_store(s, tweaks);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// نواة SHA-256 متعددة الرسائل: كل مسار في V يحمل رسالة مستقلة بنفس الطول.
+// تُضمَّن فقط من ملفات hash_mb*.cpp التي تبني القالب لكل معمارية.
+
+#include <utility>
+
+#include "simd.h"
+
+static constexpr uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static constexpr uint32_t SHA256_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+// أطول رسالة تدعمها النواة: كتلتان بعد الحشو (65 بايت للمفتاح العام غير المضغوط)
+static const size_t SHA256_MB_MAX_LEN = 119;
+
+template <class V>
+static inline V sha256_mb_sigma0(V x) {
+    return V::template rotr<7>(x) ^ V::template rotr<18>(x) ^ V::template shr<3>(x);
+}
+
+template <class V>
+static inline V sha256_mb_sigma1(V x) {
+    return V::template rotr<17>(x) ^ V::template rotr<19>(x) ^ V::template shr<10>(x);
+}
+
+// الجولة T: المتغيرات a..h تدور داخل x[8] بفهارس ثابتة وقت الترجمة
+template <class V, int T>
+static inline void sha256_mb_round(V x[8], V w[64]) {
+    V& a = x[(0 - T) & 7]; V& b = x[(1 - T) & 7]; V& c = x[(2 - T) & 7]; V& d = x[(3 - T) & 7];
+    V& e = x[(4 - T) & 7]; V& f = x[(5 - T) & 7]; V& g = x[(6 - T) & 7]; V& h = x[(7 - T) & 7];
+    if constexpr (T >= 16) {
+        w[T] = sha256_mb_sigma1(w[T - 2]) + w[T - 7] + (sha256_mb_sigma0(w[T - 15]) + w[T - 16]);
+    }
+    V s1 = V::template rotr<6>(e) ^ V::template rotr<11>(e) ^ V::template rotr<25>(e);
+    V ch = (e & f) ^ V::andnot(e, g);
+    V t1 = h + s1 + ch + (V::set1(SHA256_K[T]) + w[T]);
+    V s0 = V::template rotr<2>(a) ^ V::template rotr<13>(a) ^ V::template rotr<22>(a);
+    V maj = (a & b) | (c & (a | b));
+    d = d + t1;
+    h = t1 + s0 + maj;
+}
+
+template <class V, int... T>
+static inline void sha256_mb_rounds(V x[8], V w[64], std::integer_sequence<int, T...>) {
+    (sha256_mb_round<V, T>(x, w), ...);
+}
+
+// ضغط كتلة واحدة: w[0..15] كلمات الكتلة لكل المسارات (تُوسَّع في مكانها)، s[8] الحالة.
+// الحلقات مفرودة بالكامل، فالكلمات الثابتة (الحشو والطول) تُطوى مع K وقت الترجمة.
+template <class V>
+static inline void sha256_mb_compress(V s[8], V w[64]) {
+    V x[8];
+    for (int i = 0; i < 8; ++i) x[i] = s[i];
+    sha256_mb_rounds<V>(x, w, std::make_integer_sequence<int, 64>());
+    for (int i = 0; i < 8; ++i) s[i] = s[i] + x[i];
+}
+
+// يجزّئ V::LANES رسائل بطول len (حتى SHA256_MB_MAX_LEN)، والناتج يبقى في s[8]
+// بترتيب المسارات حتى تستهلكه المرحلة التالية بدون إعادة ترتيب
+template <class V>
+static inline void sha256_mb_hash(const unsigned char* const* msgs, size_t len, V s[8]) {
+    const int L = V::LANES;
+    const size_t blocks = (len + 9 + 63) / 64;
+
+    unsigned char padded[L][128];
+    for (int l = 0; l < L; ++l) {
+        memcpy(padded[l], msgs[l], len);
+        memset(padded[l] + len, 0, blocks * 64 - len);
+        padded[l][len] = 0x80;
+        store_be32(padded[l] + blocks * 64 - 4, (uint32_t)(len * 8));
+    }
+
+    for (int i = 0; i < 8; ++i) s[i] = V::set1(SHA256_IV[i]);
+    for (size_t blk = 0; blk < blocks; ++blk) {
+        V w[64];
+        for (int i = 0; i < 16; ++i) {
+            uint32_t lanes[L];
+            for (int l = 0; l < L; ++l) lanes[l] = load_be32(padded[l] + blk * 64 + i * 4);
+            w[i] = V::load(lanes);
+        }
+        sha256_mb_compress(s, w);
+    }
+}
+
+template <class V>
+static inline void sha256_mb_store(const V s[8], unsigned char (*digests)[32]) {
+    const int L = V::LANES;
+    uint32_t lanes[8][L];
+    for (int i = 0; i < 8; ++i) s[i].store(lanes[i]);
+    for (int l = 0; l < L; ++l)
+        for (int i = 0; i < 8; ++i) store_be32(digests[l] + i * 4, lanes[i][l]);
+}
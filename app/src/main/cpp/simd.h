@@ -0,0 +1,149 @@
+#pragma once
+
+// غلاف متجهات 32-بت متعدد المسارات تستخدمه نوى التجزئة متعددة الرسائل.
+// كل نوع يعرّف LANES وعمليات الجمع والمنطق والإزاحة على كل المسارات معًا،
+// والنواة نفسها تكتب مرة واحدة كقالب فوق هذا النوع.
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+enum class SimdBackend { Scalar, SSE41, AVX2, NEON };
+
+// مسار واحد: المرجع المحمول الذي يعمل على كل المعماريات
+struct VecScalar {
+    static constexpr int LANES = 1;
+    uint32_t v;
+
+    static inline VecScalar set1(uint32_t x) { return {x}; }
+    static inline VecScalar load(const uint32_t* p) { return {p[0]}; }
+    inline void store(uint32_t* p) const { p[0] = v; }
+
+    friend inline VecScalar operator+(VecScalar a, VecScalar b) { return {a.v + b.v}; }
+    friend inline VecScalar operator^(VecScalar a, VecScalar b) { return {a.v ^ b.v}; }
+    friend inline VecScalar operator&(VecScalar a, VecScalar b) { return {a.v & b.v}; }
+    friend inline VecScalar operator|(VecScalar a, VecScalar b) { return {a.v | b.v}; }
+    // ~a & b
+    static inline VecScalar andnot(VecScalar a, VecScalar b) { return {~a.v & b.v}; }
+    static inline VecScalar ornot(VecScalar a, VecScalar b) { return {a.v | ~b.v}; }
+    static inline VecScalar bswap(VecScalar a) { return {__builtin_bswap32(a.v)}; }
+    template <int N> static inline VecScalar shr(VecScalar a) { return {a.v >> N}; }
+    template <int N> static inline VecScalar shl(VecScalar a) { return {a.v << N}; }
+    template <int N> static inline VecScalar rotr(VecScalar a) { return {(a.v >> N) | (a.v << (32 - N))}; }
+    template <int N> static inline VecScalar rotl(VecScalar a) { return {(a.v << N) | (a.v >> (32 - N))}; }
+};
+
+#if defined(__SSE4_1__)
+struct VecSSE41 {
+    static constexpr int LANES = 4;
+    __m128i v;
+
+    static inline VecSSE41 set1(uint32_t x) { return {_mm_set1_epi32((int)x)}; }
+    static inline VecSSE41 load(const uint32_t* p) { return {_mm_loadu_si128((const __m128i*)p)}; }
+    inline void store(uint32_t* p) const { _mm_storeu_si128((__m128i*)p, v); }
+
+    friend inline VecSSE41 operator+(VecSSE41 a, VecSSE41 b) { return {_mm_add_epi32(a.v, b.v)}; }
+    friend inline VecSSE41 operator^(VecSSE41 a, VecSSE41 b) { return {_mm_xor_si128(a.v, b.v)}; }
+    friend inline VecSSE41 operator&(VecSSE41 a, VecSSE41 b) { return {_mm_and_si128(a.v, b.v)}; }
+    friend inline VecSSE41 operator|(VecSSE41 a, VecSSE41 b) { return {_mm_or_si128(a.v, b.v)}; }
+    static inline VecSSE41 andnot(VecSSE41 a, VecSSE41 b) { return {_mm_andnot_si128(a.v, b.v)}; }
+    static inline VecSSE41 ornot(VecSSE41 a, VecSSE41 b) {
+        return {_mm_or_si128(a.v, _mm_xor_si128(b.v, _mm_set1_epi32(-1)))};
+    }
+    static inline VecSSE41 bswap(VecSSE41 a) {
+        return {_mm_shuffle_epi8(a.v, _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3))};
+    }
+    template <int N> static inline VecSSE41 shr(VecSSE41 a) { return {_mm_srli_epi32(a.v, N)}; }
+    template <int N> static inline VecSSE41 shl(VecSSE41 a) { return {_mm_slli_epi32(a.v, N)}; }
+    template <int N> static inline VecSSE41 rotr(VecSSE41 a) {
+        return {_mm_or_si128(_mm_srli_epi32(a.v, N), _mm_slli_epi32(a.v, 32 - N))};
+    }
+    template <int N> static inline VecSSE41 rotl(VecSSE41 a) {
+        return {_mm_or_si128(_mm_slli_epi32(a.v, N), _mm_srli_epi32(a.v, 32 - N))};
+    }
+};
+#endif
+
+#if defined(__AVX2__)
+struct VecAVX2 {
+    static constexpr int LANES = 8;
+    __m256i v;
+
+    static inline VecAVX2 set1(uint32_t x) { return {_mm256_set1_epi32((int)x)}; }
+    static inline VecAVX2 load(const uint32_t* p) { return {_mm256_loadu_si256((const __m256i*)p)}; }
+    inline void store(uint32_t* p) const { _mm256_storeu_si256((__m256i*)p, v); }
+
+    friend inline VecAVX2 operator+(VecAVX2 a, VecAVX2 b) { return {_mm256_add_epi32(a.v, b.v)}; }
+    friend inline VecAVX2 operator^(VecAVX2 a, VecAVX2 b) { return {_mm256_xor_si256(a.v, b.v)}; }
+    friend inline VecAVX2 operator&(VecAVX2 a, VecAVX2 b) { return {_mm256_and_si256(a.v, b.v)}; }
+    friend inline VecAVX2 operator|(VecAVX2 a, VecAVX2 b) { return {_mm256_or_si256(a.v, b.v)}; }
+    static inline VecAVX2 andnot(VecAVX2 a, VecAVX2 b) { return {_mm256_andnot_si256(a.v, b.v)}; }
+    static inline VecAVX2 ornot(VecAVX2 a, VecAVX2 b) {
+        return {_mm256_or_si256(a.v, _mm256_xor_si256(b.v, _mm256_set1_epi32(-1)))};
+    }
+    static inline VecAVX2 bswap(VecAVX2 a) {
+        return {_mm256_shuffle_epi8(a.v, _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                                         12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3))};
+    }
+    template <int N> static inline VecAVX2 shr(VecAVX2 a) { return {_mm256_srli_epi32(a.v, N)}; }
+    template <int N> static inline VecAVX2 shl(VecAVX2 a) { return {_mm256_slli_epi32(a.v, N)}; }
+    template <int N> static inline VecAVX2 rotr(VecAVX2 a) {
+        return {_mm256_or_si256(_mm256_srli_epi32(a.v, N), _mm256_slli_epi32(a.v, 32 - N))};
+    }
+    template <int N> static inline VecAVX2 rotl(VecAVX2 a) {
+        return {_mm256_or_si256(_mm256_slli_epi32(a.v, N), _mm256_srli_epi32(a.v, 32 - N))};
+    }
+};
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+struct VecNEON {
+    static constexpr int LANES = 4;
+    uint32x4_t v;
+
+    static inline VecNEON set1(uint32_t x) { return {vdupq_n_u32(x)}; }
+    static inline VecNEON load(const uint32_t* p) { return {vld1q_u32(p)}; }
+    inline void store(uint32_t* p) const { vst1q_u32(p, v); }
+
+    friend inline VecNEON operator+(VecNEON a, VecNEON b) { return {vaddq_u32(a.v, b.v)}; }
+    friend inline VecNEON operator^(VecNEON a, VecNEON b) { return {veorq_u32(a.v, b.v)}; }
+    friend inline VecNEON operator&(VecNEON a, VecNEON b) { return {vandq_u32(a.v, b.v)}; }
+    friend inline VecNEON operator|(VecNEON a, VecNEON b) { return {vorrq_u32(a.v, b.v)}; }
+    // vbicq(b, a) = b & ~a
+    static inline VecNEON andnot(VecNEON a, VecNEON b) { return {vbicq_u32(b.v, a.v)}; }
+    static inline VecNEON ornot(VecNEON a, VecNEON b) { return {vornq_u32(a.v, b.v)}; }
+    static inline VecNEON bswap(VecNEON a) { return {vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(a.v)))}; }
+    template <int N> static inline VecNEON shr(VecNEON a) { return {vshrq_n_u32(a.v, N)}; }
+    template <int N> static inline VecNEON shl(VecNEON a) { return {vshlq_n_u32(a.v, N)}; }
+    template <int N> static inline VecNEON rotr(VecNEON a) { return {vsriq_n_u32(vshlq_n_u32(a.v, 32 - N), a.v, N)}; }
+    template <int N> static inline VecNEON rotl(VecNEON a) { return {vsriq_n_u32(vshlq_n_u32(a.v, N), a.v, 32 - N)}; }
+};
+#endif
+
+static inline uint32_t load_be32(const unsigned char* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void store_be32(unsigned char* p, uint32_t x) {
+    p[0] = (unsigned char)(x >> 24);
+    p[1] = (unsigned char)(x >> 16);
+    p[2] = (unsigned char)(x >> 8);
+    p[3] = (unsigned char)x;
+}
+
+static inline uint32_t load_le32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void store_le32(unsigned char* p, uint32_t x) {
+    p[0] = (unsigned char)x;
+    p[1] = (unsigned char)(x >> 8);
+    p[2] = (unsigned char)(x >> 16);
+    p[3] = (unsigned char)(x >> 24);
+}
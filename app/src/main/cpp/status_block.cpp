@@ -0,0 +1,39 @@
+#include "status_block.h"
+
+#include <cstring>
+
+static_assert(sizeof(SearchStatus) % 8 == 0, "status words are 64-bit");
+static_assert(offsetof(SearchStatus, found_key) == 40, "layout shared with NativeLoader.kt");
+static_assert(offsetof(SearchStatus, worker_rates) == 72, "layout shared with NativeLoader.kt");
+
+StatusBlock::StatusBlock() {
+    layout_.sequence.store(0, std::memory_order_relaxed);
+    layout_.version = STATUS_LAYOUT_VERSION;
+    for (size_t i = 0; i < WORDS; ++i) layout_.words[i].store(0, std::memory_order_relaxed);
+}
+
+void StatusBlock::publish(const SearchStatus& status) {
+    uint64_t words[WORDS];
+    memcpy(words, &status, sizeof(words));
+
+    uint32_t seq = layout_.sequence.load(std::memory_order_relaxed);
+    layout_.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i) layout_.words[i].store(words[i], std::memory_order_relaxed);
+    layout_.sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool StatusBlock::read(SearchStatus& out) const {
+    uint64_t words[WORDS];
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        uint32_t before = layout_.sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        for (size_t i = 0; i < WORDS; ++i) words[i] = layout_.words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (layout_.sequence.load(std::memory_order_relaxed) == before) {
+            memcpy(&out, words, sizeof(words));
+            return true;
+        }
+    }
+    return false;
+}
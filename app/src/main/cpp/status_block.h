@@ -0,0 +1,57 @@
+#pragma once
+
+// كتلة حالة البحث في ذاكرة مشتركة مع Kotlin (ByteBuffer مباشر)، محمية بـ seqlock:
+// الكاتب يجعل sequence فرديًا، يكتب الكلمات، ثم يعيده زوجيًا. القارئ يعيد القراءة إن وجد
+// sequence فرديًا أو تغير أثناء القراءة. لا استدعاءات JNI ولا Intents لنقل التقدم.
+//
+// التخطيط ثابت (ترتيب بايتات الجهاز) لأن NativeLoader.kt يقرؤه بالإزاحات:
+//   0  u32 sequence          4  u32 layout version
+//   8  u64 keys_checked     16  f64 keys_per_second    24  f64 coverage (0..1)
+//  32  u32 state            36  u32 hit_count          40  u32 workers          44  u32 search_id
+//  48  u64 found_key[4] (الخانة 0 هي الأقل أهمية)       80  f64 worker_rates[16]
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "uint256.h"
+
+static const uint32_t STATUS_LAYOUT_VERSION = 2;
+static const size_t STATUS_MAX_WORKERS = 16;
+
+struct SearchStatus {
+    uint64_t keys_checked;
+    double keys_per_second;
+    double coverage;
+    uint32_t state;         // SessionState
+    uint32_t hit_count;
+    uint32_t workers;
+    uint32_t search_id;     // يزيد مع كل بحث جديد
+    U256 found_key;         // صالح إن كان hit_count > 0
+    double worker_rates[STATUS_MAX_WORKERS];
+};
+
+class StatusBlock {
+public:
+    StatusBlock();
+
+    // كاتب واحد في كل مرة (الجلسة تسلسل الكتاب بقفل)
+    void publish(const SearchStatus& status);
+    // للقراء في ++C: يعيد false إن فشلت القراءة المتسقة بعد عدة محاولات
+    bool read(SearchStatus& out) const;
+
+    void* data() { return &layout_; }
+    static constexpr size_t size() { return sizeof(Layout); }
+
+private:
+    static const size_t WORDS = sizeof(SearchStatus) / 8;
+
+    // كلمات ذرية بعرض 64 بت: القراءة أثناء الكتابة محددة في ++C، والـ seqlock يكشف التمزق
+    struct alignas(64) Layout {
+        std::atomic<uint32_t> sequence;
+        uint32_t version;
+        std::atomic<uint64_t> words[WORDS];
+    };
+
+    Layout layout_;
+};
@@ -0,0 +1,188 @@
+#include "target_decode.h"
+
+#include <openssl/sha.h>
+
+#include <cstring>
+
+#include "secp256k1.h"
+
+static const char* BASE58_ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+bool base58_decode(const std::string& input, std::vector<unsigned char>& out) {
+    std::vector<unsigned char> b;
+    size_t zeroes = 0;
+    while (zeroes < input.size() && input[zeroes] == BASE58_ALPHABET[0]) zeroes++;
+
+    for (size_t i = zeroes; i < input.size(); ++i) {
+        const char* p = strchr(BASE58_ALPHABET, input[i]);
+        if (p == nullptr || input[i] == '\0') return false;
+        int carry = (int)(p - BASE58_ALPHABET);
+        for (size_t j = b.size(); j-- > 0;) {
+            int val = (int)b[j] * 58 + carry;
+            b[j] = (unsigned char)(val & 0xFF);
+            carry = val >> 8;
+        }
+        while (carry > 0) {
+            b.insert(b.begin(), (unsigned char)(carry & 0xFF));
+            carry >>= 8;
+        }
+    }
+
+    out.assign(zeroes, 0);
+    out.insert(out.end(), b.begin(), b.end());
+    return true;
+}
+
+// Base58Check: بايت الإصدار ثم 20 بايت ثم checksum من 4 بايت
+bool decode_base58check_hash160(const std::string& address, unsigned char& version,
+                                unsigned char hash160[HASH160_LEN]) {
+    std::vector<unsigned char> raw;
+    if (!base58_decode(address, raw)) return false;
+    if (raw.size() != 1 + HASH160_LEN + 4) return false;
+
+    unsigned char checksum_full[SHA256_DIGEST_LENGTH];
+    SHA256(raw.data(), 1 + HASH160_LEN, checksum_full);
+    SHA256(checksum_full, SHA256_DIGEST_LENGTH, checksum_full);
+    if (memcmp(checksum_full, &raw[1 + HASH160_LEN], 4) != 0) return false;
+
+    version = raw[0];
+    memcpy(hash160, &raw[1], HASH160_LEN);
+    return true;
+}
+
+static const char* BECH32_CHARSET = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+static const uint32_t BECH32_CONST = 1;             // BIP-173، لإصدار الشاهد 0
+static const uint32_t BECH32M_CONST = 0x2bc830a3;   // BIP-350، للإصدارات 1 فما فوق
+
+static uint32_t bech32_polymod(const std::vector<unsigned char>& values) {
+    static const uint32_t GEN[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd, 0x2a1462b3};
+    uint32_t chk = 1;
+    for (unsigned char v : values) {
+        uint32_t top = chk >> 25;
+        chk = ((chk & 0x1ffffff) << 5) ^ v;
+        for (int i = 0; i < 5; ++i) {
+            if ((top >> i) & 1) chk ^= GEN[i];
+        }
+    }
+    return chk;
+}
+
+// الحروف كلها صغيرة أو كلها كبيرة
+bool decode_segwit_address(const std::string& address, int& witness_version, std::vector<unsigned char>& program) {
+    if (address.size() < 14 || address.size() > 90) return false;
+    bool lower = false, upper = false;
+    std::string addr(address);
+    for (char& c : addr) {
+        if (c < 33 || c > 126) return false;
+        if (c >= 'a' && c <= 'z') lower = true;
+        if (c >= 'A' && c <= 'Z') {
+            upper = true;
+            c = (char)(c - 'A' + 'a');
+        }
+    }
+    if (lower && upper) return false;
+    if (addr.compare(0, 3, "bc1") != 0) return false;
+
+    // hrp موسّع ("bc") ثم قيم 5-بت للبيانات مع الـ checksum
+    std::vector<unsigned char> values = {3, 3, 0, 2, 3};
+    for (size_t i = 3; i < addr.size(); ++i) {
+        const char* p = strchr(BECH32_CHARSET, addr[i]);
+        if (p == nullptr) return false;
+        values.push_back((unsigned char)(p - BECH32_CHARSET));
+    }
+    const size_t data_start = 5, data_end = values.size() - 6;
+    if (data_end <= data_start) return false;
+    witness_version = values[data_start];
+    if (witness_version > 16) return false;
+    if (bech32_polymod(values) != (witness_version == 0 ? BECH32_CONST : BECH32M_CONST)) return false;
+
+    // 5-بت → 8-بت بلا حشو: البتات الزائدة أقل من 5 وكلها أصفار
+    program.clear();
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = data_start + 1; i < data_end; ++i) {
+        acc = (acc << 5) | values[i];
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            program.push_back((unsigned char)((acc >> bits) & 0xff));
+        }
+    }
+    if (bits >= 5 || ((acc << (8 - bits)) & 0xff) != 0) return false;
+    // الإصدار 0 معرّف لبرنامجين فقط: P2WPKH (20) و P2WSH (32)
+    if (witness_version == 0 && program.size() != HASH160_LEN && program.size() != 32) return false;
+    return program.size() >= 2 && program.size() <= 40;
+}
+
+// إحداثي من 64 خانة ست عشرية أقل من p
+static bool parse_coordinate(const std::string& hex, size_t offset, FieldElem& out) {
+    U256 value;
+    if (!u256_from_hex(hex.data() + offset, 64, value)) return false;
+    fe_set_u256(out, value);
+    return memcmp(out.n, value.d, sizeof(out.n)) == 0;
+}
+
+// مفتاح عام معروف بالست عشري: 02/03 ثم x، أو 04 ثم x و y. النقطة يجب أن تقع على المنحنى
+// (x³ + 7 مربع، و y² يساويه للصيغة الكاملة)، وإلا لا يطابقها أي مفتاح
+bool decode_public_key(const std::string& hex, TargetSpec& target) {
+    if (hex.size() != 66 && hex.size() != 130) return false;
+    const bool full = hex.size() == 130;
+    if (hex[0] != '0' || (full ? hex[1] != '4' : hex[1] != '2' && hex[1] != '3')) return false;
+    FieldElem x, rhs, seven, root;
+    if (!parse_coordinate(hex, 2, x)) return false;
+    fe_sqr(rhs, x);
+    fe_mul(rhs, rhs, x);
+    fe_set_u256(seven, u256_from_u64(7));
+    fe_add(rhs, rhs, seven);
+    bool odd = hex[1] == '3';
+    if (full) {
+        FieldElem y, lhs;
+        if (!parse_coordinate(hex, 66, y)) return false;
+        fe_sqr(lhs, y);
+        if (!fe_equal(lhs, rhs)) return false;
+        odd = fe_is_odd(y);
+    } else if (!fe_sqrt(root, rhs)) {
+        return false;
+    }
+    target.kind = TargetKind::PublicKey;
+    fe_to_be_bytes(x, target.digest);
+    target.digest[32] = odd ? 1 : 0;
+    return true;
+}
+
+// يختزل العنوان مرة واحدة إلى الملخص الذي يحسبه الخط:
+//   1...    P2PKH        hash160(pubkey)
+//   bc1q... P2WPKH       برنامج الشاهد هو hash160(pubkey المضغوط) نفسه، فلا مرحلة إضافية،
+//           ويُحسب من المفتاح المضغوط حتى إن طُلبت الصيغة غير المضغوطة
+//   3...    P2SH-P2WPKH  hash160 لسكربت الاسترداد، يحتاج تجزئة ثانية لكل مفتاح.
+//           أي سكربت P2SH آخر لا يُشتق من مفتاح واحد، فلا يمكن أن يطابق
+//   bc1p... P2TR         x للمفتاح الناتج (32 بايت) مقابل tweak المفتاح الداخلي بلا شجرة سكربتات،
+//           بلا SHA-256/RIPEMD-160 للمفتاح العام
+//   02/03/04 مفتاح عام معروف بالست عشري: x من المشي نفسه مع زوجية y، بلا تسلسل ولا تجزئة
+bool decode_target(const std::string& address, TargetSpec& target) {
+    if (decode_public_key(address, target)) return true;
+    unsigned char version;
+    if (decode_base58check_hash160(address, version, target.digest)) {
+        if (version == 0x00) {
+            target.kind = TargetKind::KeyHash;
+            return true;
+        }
+        if (version == 0x05) {
+            target.kind = TargetKind::ScriptHash;
+            return true;
+        }
+        return false;
+    }
+    int witness_version;
+    std::vector<unsigned char> program;
+    if (!decode_segwit_address(address, witness_version, program)) return false;
+    if (witness_version == 0 && program.size() == HASH160_LEN) {
+        target.kind = TargetKind::WitnessKeyHash;
+    } else if (witness_version == 1 && program.size() == 32) {
+        target.kind = TargetKind::TaprootOutput;
+    } else {
+        return false;
+    }
+    memcpy(target.digest, program.data(), program.size());
+    return true;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// فك عناوين الأهداف ومفاتيحها العامة إلى TargetSpec، مرة واحدة قبل البحث:
+// Base58Check (P2PKH و P2SH)، و bech32/bech32m للشبكة الرئيسية (BIP-173 و BIP-350)،
+// والمفتاح العام بالست عشري
+
+#include <string>
+#include <vector>
+
+#include "target_set.h"
+
+// الأبجدية فقط، بلا checksum. يعيد false عند حرف خارج Base58
+bool base58_decode(const std::string& input, std::vector<unsigned char>& out);
+
+// بايت الإصدار و hash160 بعد التحقق من الطول والـ checksum
+bool decode_base58check_hash160(const std::string& address, unsigned char& version,
+                                unsigned char hash160[HASH160_LEN]);
+
+// bc1...: إصدار الشاهد والبرنامج (2..40 بايت، و 20 أو 32 للإصدار 0)، بثابت bech32 للإصدار 0
+// و bech32m لغيره
+bool decode_segwit_address(const std::string& address, int& witness_version, std::vector<unsigned char>& program);
+
+// 02/03 + x أو 04 + x + y بالست عشري، لنقطة على المنحنى فقط
+bool decode_public_key(const std::string& hex, TargetSpec& target);
+
+// أي صيغة هدف مدعومة، أو false لغير الصالح وغير المدعوم
+bool decode_target(const std::string& address, TargetSpec& target);
@@ -0,0 +1,87 @@
+#include "target_set.h"
+
+#include <openssl/sha.h>
+
+#include <algorithm>
+
+TargetSet::TargetSet(const TargetSpec* targets, size_t count) : id_limit_(count) {
+    // الملخص الكامل لكل هدف برقمه، لمقارنة البقايا عند الترتيب
+    std::vector<const unsigned char*> digests(count);
+    for (size_t i = 0; i < count; ++i) {
+        digests[i] = targets[i].digest;
+        tables_[(size_t)targets[i].kind].entries.push_back(make_entry(targets[i].digest, (uint32_t)i));
+    }
+    for (size_t kind = 0; kind < TARGET_KINDS; ++kind) {
+        build(tables_[kind], target_digest_len((TargetKind)kind) - HASH160_LEN, digests);
+    }
+}
+
+void TargetSet::build(Table& table, size_t tail, const std::vector<const unsigned char*>& digests) {
+    // النوع الفارغ لا يحتاج فهرسًا (256 KiB): بتاته كلها صفر، فيرفض find قبل أن يلمسه
+    memset(table.presence, 0, sizeof(table.presence));
+    table.tails.clear();
+    table.index.clear();
+    if (table.entries.empty()) return;
+
+    std::vector<Entry>& entries = table.entries;
+    auto tail_cmp = [&](const Entry& a, const Entry& b) {
+        return tail == 0 ? 0 : memcmp(digests[a.id] + HASH160_LEN, digests[b.id] + HASH160_LEN, tail);
+    };
+    // ترتيب ثابت: بين المكررات يبقى الأول إدخالًا
+    std::stable_sort(entries.begin(), entries.end(), [&](const Entry& a, const Entry& b) {
+        if (a.hi != b.hi) return a.hi < b.hi;
+        if (a.mid != b.mid) return a.mid < b.mid;
+        if (a.lo != b.lo) return a.lo < b.lo;
+        return tail_cmp(a, b) < 0;
+    });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [&](const Entry& a, const Entry& b) {
+                                  return a.hi == b.hi && a.mid == b.mid && a.lo == b.lo && tail_cmp(a, b) == 0;
+                              }),
+                  entries.end());
+    for (const Entry& e : entries) {
+        table.tails.insert(table.tails.end(), digests[e.id] + HASH160_LEN, digests[e.id] + HASH160_LEN + tail);
+    }
+
+    // index[p] = عدد العناصر ذات البادئة الأقل من p
+    table.index.assign((1 << 16) + 1, 0);
+    for (const Entry& e : entries) {
+        uint32_t prefix = (uint32_t)(e.hi >> 48);
+        table.presence[prefix >> 6] |= 1ull << (prefix & 63);
+        ++table.index[prefix + 1];
+    }
+    for (size_t p = 1; p < table.index.size(); ++p) table.index[p] += table.index[p - 1];
+}
+
+bool TargetSet::single(TargetKind kind, unsigned char digest[TARGET_DIGEST_MAX], int& id) const {
+    if (size() != 1 || !has(kind)) return false;
+    const Table& table = tables_[(size_t)kind];
+    entry_digest(table.entries[0], digest);
+    memcpy(digest + HASH160_LEN, table.tails.data(), table.tails.size());
+    id = (int)table.entries[0].id;
+    return true;
+}
+
+void TargetSet::fingerprint(unsigned char out[HASH160_LEN]) const {
+    // لكل نوع: بايت النوع ثم ملخصاته المرتبة
+    std::vector<unsigned char> sorted;
+    for (size_t kind = 0; kind < TARGET_KINDS; ++kind) {
+        if (tables_[kind].entries.empty()) continue;
+        const Table& table = tables_[kind];
+        const size_t tail = target_digest_len((TargetKind)kind) - HASH160_LEN;
+        sorted.push_back((unsigned char)kind);
+        for (size_t i = 0; i < table.entries.size(); ++i) {
+            unsigned char digest[HASH160_LEN];
+            entry_digest(table.entries[i], digest);
+            sorted.insert(sorted.end(), digest, digest + HASH160_LEN);
+            sorted.insert(sorted.end(), table.tails.data() + i * tail, table.tails.data() + (i + 1) * tail);
+        }
+    }
+    if (size() == 1 && has(TargetKind::KeyHash)) {
+        memcpy(out, sorted.data() + 1, HASH160_LEN);
+        return;
+    }
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256(sorted.data(), sorted.size(), digest);
+    memcpy(out, digest, HASH160_LEN);
+}
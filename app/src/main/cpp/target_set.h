@@ -0,0 +1,127 @@
+#pragma once
+
+// مجموعة الأهداف التي تطابقها دفعات البحث، تُبنى مرة واحدة لكل بحث وتُقرأ من كل العمال.
+// كل هدف مختزل إلى الملخص الذي يحسبه الخط مباشرة، ولكل نوع ملخص جدول منفصل
+// (الملخصات الأطول من 20 بايت تُفهرس بأول 20 وتُطابق بقيتها بعد ذلك):
+//   - bitmap بـ 2^16 بت (8 KiB، يبقى في L1): بت لكل بادئة 16-بت لهدف واحد على الأقل
+//   - فهرس البادئات: أول عنصر لكل بادئة في المصفوفة المرتبة، لا يُلمس إلا إن وُجد البت
+//   - مصفوفة مرتبة بالبايتات الكبيرة أولًا للمقارنة الكاملة
+// معظم المفاتيح تُرفض بقراءة واحدة من الـ bitmap، فكلفة المطابقة لكل مفتاح شبه ثابتة
+// من هدف واحد إلى آلاف الأهداف (كثافة البتات n / 65536).
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+static const size_t HASH160_LEN = 20;
+static const size_t TARGET_DIGEST_MAX = 33;
+
+// الملخص الذي يُقارن به الهدف
+enum class TargetKind {
+    KeyHash = 0,        // hash160(pubkey) بأي صيغة: P2PKH (1...)
+    ScriptHash = 1,     // hash160(0x00 0x14 hash160(pubkey المضغوط)): P2SH-P2WPKH (3...)
+    TaprootOutput = 2,  // x للمفتاح P + H_TapTweak(P.x)*G بلا شجرة سكربتات: P2TR (bc1p...)
+    PublicKey = 3,      // مفتاح عام معروف: x (32 بايت) ثم زوجية y، يُطابق نقطة المشي بلا تجزئة
+    WitnessKeyHash = 4, // hash160(pubkey المضغوط) فقط: P2WPKH (bc1q...)
+};
+static const size_t TARGET_KINDS = 5;
+
+// أنواع لا يلتزم بها إلا المفتاح المضغوط: تُقارن بملخصاته في أي صيغة بحث
+static constexpr bool target_compressed_only(TargetKind kind) {
+    return kind == TargetKind::ScriptHash || kind == TargetKind::WitnessKeyHash;
+}
+
+static constexpr size_t target_digest_len(TargetKind kind) {
+    return kind == TargetKind::PublicKey ? 33 : kind == TargetKind::TaprootOutput ? 32 : HASH160_LEN;
+}
+
+struct TargetSpec {
+    TargetKind kind;
+    unsigned char digest[TARGET_DIGEST_MAX];    // أول target_digest_len(kind) بايت
+};
+
+class TargetSet {
+public:
+    // count هدفًا بترتيب الإدخال، والمكرر يُحفظ مرة واحدة برقم أول ظهور له
+    TargetSet(const TargetSpec* targets, size_t count);
+
+    // عدد الأهداف المختلفة، وهل بين الأهداف ما يُقارن بالملخص kind (وإلا لا يُحسب)
+    size_t size() const {
+        size_t n = 0;
+        for (const Table& table : tables_) n += table.entries.size();
+        return n;
+    }
+    bool has(TargetKind kind) const { return !tables_[(size_t)kind].entries.empty(); }
+    // حد أرقام الأهداف التي يعيدها find (عدد المدخلات قبل حذف المكرر)
+    size_t id_limit() const { return id_limit_; }
+
+    // هل بين أهداف النوع kind ما يبدأ بالبادئة 16-بت prefix: الرفض المبكر لمن يملك أول
+    // البايتات دون الملخص كاملًا (x من المشي مباشرة)
+    bool maybe(TargetKind kind, uint32_t prefix) const {
+        return (tables_[(size_t)kind].presence[prefix >> 6] >> (prefix & 63)) & 1;
+    }
+
+    // رقم الهدف (ترتيب الإدخال) من النوع kind الذي يساوي digest، أو -1
+    int find(TargetKind kind, const unsigned char* digest) const {
+        const Table& table = tables_[(size_t)kind];
+        uint32_t prefix = ((uint32_t)digest[0] << 8) | digest[1];
+        if (!maybe(kind, prefix)) return -1;
+        Entry key = make_entry(digest, 0);
+        const size_t tail = target_digest_len(kind) - HASH160_LEN;
+        for (uint32_t i = table.index[prefix], end = table.index[prefix + 1]; i < end; ++i) {
+            const Entry& e = table.entries[i];
+            if (e.hi != key.hi || e.mid != key.mid || e.lo != key.lo) continue;
+            if (tail == 0 || memcmp(digest + HASH160_LEN, &table.tails[i * tail], tail) == 0) return (int)e.id;
+        }
+        return -1;
+    }
+
+    // المجموعة كلها هدف واحد من النوع kind: ملخصه ورقمه، لمسار المقارنة المباشرة
+    bool single(TargetKind kind, unsigned char digest[TARGET_DIGEST_MAX], int& id) const;
+
+    // 20 بايت تميز المجموعة في هوية نقطة الاستئناف: hash160 نفسه لهدف P2PKH واحد
+    // (فتبقى نقاط الاستئناف السابقة صالحة)، و SHA-256 للقوائم المرتبة مقتطعًا لغيره
+    void fingerprint(unsigned char out[HASH160_LEN]) const;
+
+private:
+    // البايتات الكبيرة أولًا في hi و mid و lo، فترتيب الأعداد هو ترتيب البايتات
+    struct Entry {
+        uint64_t hi;
+        uint64_t mid;
+        uint32_t lo;
+        uint32_t id;
+    };
+
+    struct Table {
+        std::vector<Entry> entries;
+        std::vector<unsigned char> tails;   // ما بعد أول 20 بايت لكل عنصر، للملخصات الأطول
+        std::vector<uint32_t> index;    // 2^16 + 1: البادئة p في [index[p], index[p + 1])
+        uint64_t presence[(1 << 16) / 64];
+    };
+
+    static Entry make_entry(const unsigned char* digest, uint32_t id) {
+        Entry e;
+        memcpy(&e.hi, digest, 8);
+        memcpy(&e.mid, digest + 8, 8);
+        memcpy(&e.lo, digest + 16, 4);
+        e.hi = __builtin_bswap64(e.hi);
+        e.mid = __builtin_bswap64(e.mid);
+        e.lo = __builtin_bswap32(e.lo);
+        e.id = id;
+        return e;
+    }
+
+    static void entry_digest(const Entry& e, unsigned char* digest) {
+        uint64_t hi = __builtin_bswap64(e.hi), mid = __builtin_bswap64(e.mid);
+        uint32_t lo = __builtin_bswap32(e.lo);
+        memcpy(digest, &hi, 8);
+        memcpy(digest + 8, &mid, 8);
+        memcpy(digest + 16, &lo, 4);
+    }
+
+    static void build(Table& table, size_t tail, const std::vector<const unsigned char*>& digests);
+
+    Table tables_[TARGET_KINDS];
+    size_t id_limit_;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+// عدد صحيح بدون إشارة بطول 256 بت: أربع خانات 64-بت، الخانة 0 هي الأقل أهمية.
+// يستعمل للمفاتيح الخاصة (scalars) ولعناصر حقل secp256k1.
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SIZEOF_INT128__)
+typedef unsigned __int128 uint128_t;
+#endif
+
+struct U256 {
+    uint64_t d[4];
+};
+
+// a * b = hi:lo
+static inline uint64_t mul64(uint64_t a, uint64_t b, uint64_t* hi) {
+#if defined(__SIZEOF_INT128__)
+    uint128_t r = (uint128_t)a * b;
+    *hi = (uint64_t)(r >> 64);
+    return (uint64_t)r;
+#else
+    // armeabi-v7a: لا يوجد __int128، نقسم إلى أنصاف 32-بت
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+    uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+    *hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+    return (mid << 32) | (uint32_t)p0;
+#endif
+}
+
+// a + b + carry_in، والمحمول الخارج (0 أو 1) في carry_out
+static inline uint64_t addc64(uint64_t a, uint64_t b, uint64_t carry_in, uint64_t* carry_out) {
+    uint64_t s = a + b;
+    uint64_t c = s < a;
+    uint64_t r = s + carry_in;
+    c += r < s;
+    *carry_out = c;
+    return r;
+}
+
+// a - b - borrow_in، والاستلاف الخارج (0 أو 1) في borrow_out
+static inline uint64_t subb64(uint64_t a, uint64_t b, uint64_t borrow_in, uint64_t* borrow_out) {
+    uint64_t d = a - b;
+    uint64_t c = a < b;
+    uint64_t r = d - borrow_in;
+    c += d < borrow_in;
+    *borrow_out = c;
+    return r;
+}
+
+static inline U256 u256_from_u64(uint64_t x) {
+    U256 r = {{x, 0, 0, 0}};
+    return r;
+}
+
+static inline bool u256_is_zero(const U256& a) {
+    return (a.d[0] | a.d[1] | a.d[2] | a.d[3]) == 0;
+}
+
+static inline int u256_cmp(const U256& a, const U256& b) {
+    for (int i = 3; i >= 0; --i) {
+        if (a.d[i] != b.d[i]) return a.d[i] < b.d[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// r = a + b، ويعيد المحمول الخارج
+static inline uint64_t u256_add(U256& r, const U256& a, const U256& b) {
+    uint64_t c = 0;
+    for (int i = 0; i < 4; ++i) r.d[i] = addc64(a.d[i], b.d[i], c, &c);
+    return c;
+}
+
+// r = a - b، ويعيد الاستلاف الخارج
+static inline uint64_t u256_sub(U256& r, const U256& a, const U256& b) {
+    uint64_t c = 0;
+    for (int i = 0; i < 4; ++i) r.d[i] = subb64(a.d[i], b.d[i], c, &c);
+    return c;
+}
+
+static inline uint64_t u256_add_u64(U256& r, const U256& a, uint64_t b) {
+    return u256_add(r, a, u256_from_u64(b));
+}
+
+// r = a * b، ويعيد الخانة الخارجة (0 إن لم يفض)
+static inline uint64_t u256_mul_u64(U256& r, const U256& a, uint64_t b) {
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        uint64_t hi, c;
+        uint64_t lo = mul64(a.d[i], b, &hi);
+        r.d[i] = addc64(lo, carry, 0, &c);
+        carry = hi + c;
+    }
+    return carry;
+}
+
+static inline bool u256_fits_u64(const U256& a) {
+    return (a.d[1] | a.d[2] | a.d[3]) == 0;
+}
+
+// q = a / b و rem = a % b بالقسمة الطويلة بتًا بتًا، و b غير صفر. لإعداد البحث فقط، لا للحلقة الساخنة
+static inline void u256_divmod(const U256& a, const U256& b, U256& q, U256& rem) {
+    q = u256_from_u64(0);
+    rem = u256_from_u64(0);
+    for (int bit = 255; bit >= 0; --bit) {
+        uint64_t top = rem.d[3] >> 63;
+        for (int i = 3; i > 0; --i) rem.d[i] = (rem.d[i] << 1) | (rem.d[i - 1] >> 63);
+        rem.d[0] = (rem.d[0] << 1) | ((a.d[bit >> 6] >> (bit & 63)) & 1);
+        if (top || u256_cmp(rem, b) >= 0) {
+            u256_sub(rem, rem, b);
+            q.d[bit >> 6] |= 1ull << (bit & 63);
+        }
+    }
+}
+
+// تقريبي (53 بت)، للنسب والعرض فقط
+static inline double u256_to_double(const U256& a) {
+    double r = 0;
+    for (int i = 3; i >= 0; --i) r = r * 18446744073709551616.0 + (double)a.d[i];
+    return r;
+}
+
+static inline void u256_to_be_bytes(const U256& a, unsigned char out[32]) {
+    for (int i = 0; i < 4; ++i) {
+        uint64_t w = a.d[3 - i];
+        for (int j = 0; j < 8; ++j) out[i * 8 + j] = (unsigned char)(w >> (56 - 8 * j));
+    }
+}
+
+static inline U256 u256_from_be_bytes(const unsigned char in[32]) {
+    U256 r;
+    for (int i = 0; i < 4; ++i) {
+        uint64_t w = 0;
+        for (int j = 0; j < 8; ++j) w = (w << 8) | in[i * 8 + j];
+        r.d[3 - i] = w;
+    }
+    return r;
+}
+
+static inline bool u256_bit(const U256& a, int bit) {
+    return (a.d[bit >> 6] >> (bit & 63)) & 1;
+}
+
+// 64 خانة ست عشرية بأحرف صغيرة مع الأصفار البادئة، و out[64] = 0
+static inline void u256_to_hex(const U256& a, char out[65]) {
+    static const char HEX[] = "0123456789abcdef";
+    for (int i = 0; i < 64; ++i) out[i] = HEX[(a.d[(63 - i) / 16] >> (((63 - i) % 16) * 4)) & 0xF];
+    out[64] = 0;
+}
+
+// من 1 إلى 64 خانة ست عشرية (دون 0x)، ويعيد false عند أي حرف آخر
+static inline bool u256_from_hex(const char* hex, size_t len, U256& out) {
+    if (len == 0 || len > 64) return false;
+    out = u256_from_u64(0);
+    for (size_t i = 0; i < len; ++i) {
+        char c = hex[len - 1 - i];
+        uint64_t v;
+        if (c >= '0' && c <= '9') v = (uint64_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') v = (uint64_t)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v = (uint64_t)(c - 'A' + 10);
+        else return false;
+        out.d[i / 16] |= v << ((i % 16) * 4);
+    }
+    return true;
+}
@@ -1,10 +1,7 @@
 package com.example.keysearchapp
 
 import android.Manifest
-import android.content.BroadcastReceiver
-import android.content.Context
 import android.content.Intent
-import android.content.IntentFilter
 import android.content.pm.PackageManager
 import android.os.Build
 import android.os.Bundle
@@ -12,9 +9,16 @@ import android.widget.*
 import androidx.activity.result.contract.ActivityResultContracts
 import androidx.appcompat.app.AppCompatActivity
 import androidx.core.content.ContextCompat
+import androidx.lifecycle.ViewModelProvider
+import java.math.BigInteger
 
 class MainActivity : AppCompatActivity() {
 
+    companion object {
+        // رتبة secp256k1: المفاتيح الخاصة الصالحة أقل منها
+        private val CURVE_ORDER = BigInteger("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", 16)
+    }
+
     private lateinit var startBtn: Button
     private lateinit var pauseBtn: Button
     private lateinit var resumeBtn: Button
@@ -22,9 +26,13 @@ class MainActivity : AppCompatActivity() {
     private lateinit var targetEdit: EditText
     private lateinit var startEdit: EditText
     private lateinit var endEdit: EditText
+    private lateinit var pubkeyModeGroup: RadioGroup
+    private lateinit var performanceCoresCheck: CheckBox
+    private lateinit var randomOrderCheck: CheckBox
     private lateinit var statusText: TextView
     private lateinit var progressStatsText: TextView
     private lateinit var progressBar: ProgressBar
+    private lateinit var viewModel: SearchViewModel
 
     private val requestPerm = registerForActivityResult(ActivityResultContracts.RequestMultiplePermissions()) { perms ->
         if (perms[Manifest.permission.WRITE_EXTERNAL_STORAGE] == false) {
@@ -43,22 +51,62 @@ class MainActivity : AppCompatActivity() {
         targetEdit = findViewById(R.id.targetEdit)
         startEdit = findViewById(R.id.startEdit)
         endEdit = findViewById(R.id.endEdit)
+        pubkeyModeGroup = findViewById(R.id.pubkeyModeGroup)
+        performanceCoresCheck = findViewById(R.id.performanceCoresCheck)
+        randomOrderCheck = findViewById(R.id.randomOrderCheck)
         statusText = findViewById(R.id.statusText)
         progressStatsText = findViewById(R.id.progressStatsText)
         progressBar = findViewById(R.id.progressBar)
 
         checkAndRequestPerms()
 
+        // التقدم من كتلة الحالة الأصلية عبر SearchViewModel، مقروءًا كل إطار
+        viewModel = ViewModelProvider(this)[SearchViewModel::class.java]
+        viewModel.statsText.observe(this) { progressStatsText.text = it }
+        viewModel.progress.observe(this) {
+            progressBar.isIndeterminate = false
+            progressBar.progress = it
+        }
+        viewModel.searchState.observe(this) {
+            when (it) {
+                SearchViewModel.State.SEARCHING -> statusText.text = "جاري البحث..."
+                SearchViewModel.State.PAUSED -> statusText.text = "تم إيقاف البحث مؤقتًا."
+                SearchViewModel.State.STOPPED -> statusText.text = "انتهى البحث"
+                else -> {}
+            }
+        }
+        viewModel.foundKey.observe(this) { key ->
+            if (key != null) statusText.text = "تم العثور على المفتاح: $key"
+        }
+
+        // ما حُفظ في تشغيلات سابقة لا يضيع ولو قُتلت الخدمة بعد الإصابة مباشرة
+        val saved = NativeLoader.foundKeys(filesDir.absolutePath)
+        if (saved.isNotEmpty()) {
+            statusText.text = "مفاتيح محفوظة (${saved.size}):\n" + saved.joinToString("\n")
+        }
+
         startBtn.setOnClickListener {
-            val start = startEdit.text.toString().toLongOrNull() ?: 0L
-            val end = endEdit.text.toString().toLongOrNull() ?: 1000000L
+            val start = parseKey(startEdit.text.toString()) ?: BigInteger.ZERO
+            val end = parseKey(endEdit.text.toString()) ?: BigInteger.valueOf(1000000L)
+            if (start > end || end >= CURVE_ORDER) {
+                Toast.makeText(this, "نطاق غير صالح: يجب أن تكون البداية ≤ النهاية < n", Toast.LENGTH_SHORT).show()
+                return@setOnClickListener
+            }
             val target = targetEdit.text.toString()
-            if (target.isNotEmpty()) {
+            val pubkeyMode = when (pubkeyModeGroup.checkedRadioButtonId) {
+                R.id.modeUncompressed -> SearchService.PUBKEY_UNCOMPRESSED
+                R.id.modeBoth -> SearchService.PUBKEY_BOTH
+                else -> SearchService.PUBKEY_COMPRESSED
+            }
+            if (target.isNotBlank()) {
                 val serviceIntent = Intent(this, SearchService::class.java).apply {
                     action = "START"
-                    putExtra("start", start)
-                    putExtra("end", end)
+                    putExtra("start", start.toString(16))
+                    putExtra("end", end.toString(16))
                     putExtra("target", target)
+                    putExtra("pubkeyMode", pubkeyMode)
+                    putExtra("performanceCoresOnly", performanceCoresCheck.isChecked)
+                    putExtra("randomOrder", randomOrderCheck.isChecked)
                 }
                 ContextCompat.startForegroundService(this, serviceIntent)
                 statusText.text = "بدأ البحث في الخلفية..."
@@ -83,14 +131,13 @@ class MainActivity : AppCompatActivity() {
         }
     }
 
-    override fun onResume() {
-        super.onResume()
-        registerReceiver(receiver, IntentFilter("SEARCH_UPDATE"))
-    }
-
-    override fun onPause() {
-        super.onPause()
-        unregisterReceiver(receiver)
+    // عشري، أو ست عشري بالبادئة 0x؛ null للفارغ أو غير الصالح أو السالب
+    private fun parseKey(text: String): BigInteger? {
+        val s = text.trim()
+        if (s.isEmpty()) return null
+        val value = if (s.startsWith("0x", ignoreCase = true)) s.substring(2).toBigIntegerOrNull(16)
+                    else s.toBigIntegerOrNull()
+        return value?.takeIf { it.signum() >= 0 }
     }
 
     private fun sendCommandToService(action: String) {
@@ -98,33 +145,6 @@ class MainActivity : AppCompatActivity() {
         ContextCompat.startForegroundService(this, intent)
     }
 
-    private val receiver = object : BroadcastReceiver() {
-        override fun onReceive(context: Context?, intent: Intent?) {
-            if (intent == null) return
-            when (intent.action) {
-                "SEARCH_UPDATE" -> {
-                    val progress = intent.getLongExtra("progress", -1)
-                    val foundKey = intent.getStringExtra("foundKey")
-                    val finished = intent.getBooleanExtra("finished", false)
-
-                    if (progress >= 0) {
-                        progressStatsText.text = "تم فحص: $progress مفتاح"
-                        progressBar.isIndeterminate = false
-                        progressBar.progress = (progress % 100).toInt()
-                    }
-
-                    if (foundKey != null) {
-                        statusText.text = "تم العثور على المفتاح: $foundKey"
-                    }
-
-                    if (finished) {
-                        statusText.text = "انتهى البحث"
-                    }
-                }
-            }
-        }
-    }
-
     private fun checkAndRequestPerms() {
         if (Build.VERSION.SDK_INT < 30) {
             val perms = arrayOf(
@@ -1,7 +1,5 @@
 package com.example.keysearchapp
 
 interface NativeCallback {
-    fun onKeyFound(key: String)
-    fun onProgressUpdate(keysChecked: Long)
     fun onSearchFinished()
 }
\ No newline at end of file
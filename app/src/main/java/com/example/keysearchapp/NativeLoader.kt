@@ -1,7 +1,108 @@
 package com.example.keysearchapp
 
+import android.os.Build
+import java.lang.invoke.VarHandle
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+// نسخة من كتلة الحالة الأصلية، يعاد استخدامها في كل قراءة بدل إنشاء كائن لكل إطار
+class SearchStatus {
+    var sequence = 0
+    var keysChecked = 0L
+    var keysPerSecond = 0.0
+    var coverage = 0.0
+    var state = NativeLoader.STATE_IDLE
+    var hitCount = 0
+    var workers = 0
+    var searchId = 0
+    // خانات 64-بت للمفتاح الموجود، الخانة 0 هي الأقل أهمية
+    val foundKey = LongArray(4)
+    val workerRates = DoubleArray(NativeLoader.MAX_WORKERS)
+}
+
 object NativeLoader {
     init {
         System.loadLibrary("native-lib")
     }
-}
\ No newline at end of file
+
+    // نفس SessionState و تخطيط status_block.h
+    const val STATE_IDLE = 0
+    const val STATE_RUNNING = 1
+    const val STATE_PAUSED = 2
+    const val STATE_STOPPING = 3
+
+    const val MAX_WORKERS = 16
+    private const val LAYOUT_VERSION = 2
+    private const val OFF_SEQUENCE = 0
+    private const val OFF_VERSION = 4
+    private const val OFF_KEYS_CHECKED = 8
+    private const val OFF_KEYS_PER_SECOND = 16
+    private const val OFF_COVERAGE = 24
+    private const val OFF_STATE = 32
+    private const val OFF_HIT_COUNT = 36
+    private const val OFF_WORKERS = 40
+    private const val OFF_SEARCH_ID = 44
+    private const val OFF_FOUND_KEY = 48
+    private const val OFF_WORKER_RATES = 80
+
+    private const val READ_ATTEMPTS = 16
+
+    // ByteBuffer مباشر على ذاكرة الجلسة الأصلية، عنوانه ثابت طوال عمر العملية
+    private val status: ByteBuffer by lazy { statusBuffer().order(ByteOrder.nativeOrder()) }
+
+    // قارئ واحد (خيط الواجهة)، فتكفي مصفوفات مؤقتة واحدة لقراءة قد تُرفض
+    private val ratesScratch = DoubleArray(MAX_WORKERS)
+    private val keyScratch = LongArray(4)
+
+    external fun statusBuffer(): ByteBuffer
+
+    // std::atomic_thread_fence(acquire): على arm64 هو dmb ishld، يرتب القراءات السابقة قبل اللاحقة
+    private external fun acquireFence()
+
+    // المفاتيح المحفوظة في dataDir/found_keys.log: "scalar address format first-last timestamp" لكل سطر
+    external fun foundKeys(dataDir: String): Array<String>
+
+    // قراءة seqlock: تعيد false إن لم يتغير sequence منذ into.sequence (لا جديد)، أو إن تعارضت
+    // كل المحاولات مع الكاتب، أو لم يطابق الإصدار. into تبقى كما هي عندها.
+    fun readStatus(into: SearchStatus): Boolean {
+        val buf = status
+        if (buf.getInt(OFF_VERSION) != LAYOUT_VERSION) return false
+        repeat(READ_ATTEMPTS) {
+            val before = buf.getInt(OFF_SEQUENCE)
+            if (before == into.sequence) return false
+            if (before and 1 != 0) return@repeat
+            loadFence()
+            val keysChecked = buf.getLong(OFF_KEYS_CHECKED)
+            val keysPerSecond = buf.getDouble(OFF_KEYS_PER_SECOND)
+            val coverage = buf.getDouble(OFF_COVERAGE)
+            val state = buf.getInt(OFF_STATE)
+            val hitCount = buf.getInt(OFF_HIT_COUNT)
+            for (i in 0 until 4) keyScratch[i] = buf.getLong(OFF_FOUND_KEY + i * 8)
+            val workers = buf.getInt(OFF_WORKERS)
+            val searchId = buf.getInt(OFF_SEARCH_ID)
+            for (i in 0 until MAX_WORKERS) ratesScratch[i] = buf.getDouble(OFF_WORKER_RATES + i * 8)
+            loadFence()
+            if (buf.getInt(OFF_SEQUENCE) == before) {
+                into.sequence = before
+                into.keysChecked = keysChecked
+                into.keysPerSecond = keysPerSecond
+                into.coverage = coverage
+                into.state = state
+                into.hitCount = hitCount
+                keyScratch.copyInto(into.foundKey)
+                into.workers = minOf(workers, MAX_WORKERS)
+                into.searchId = searchId
+                ratesScratch.copyInto(into.workerRates)
+                return true
+            }
+        }
+        return false
+    }
+
+    // قراءات ByteBuffer عادية ولا ترتيب لها في نموذج ذاكرة Java، فيلزم حاجز بين sequence والبيانات.
+    // VarHandle.acquireFence من API 33، وقبله حاجز acquire أصلي عبر JNI. كتابة volatile لا تكفي:
+    // ART يصدرها على arm64 كـ stlr وحدها، ولا ترتب القراءات التي تليها
+    private fun loadFence() {
+        if (Build.VERSION.SDK_INT >= 33) VarHandle.acquireFence() else acquireFence()
+    }
+}
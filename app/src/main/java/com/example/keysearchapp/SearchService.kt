@@ -1,14 +1,32 @@
 package com.example.keysearchapp
 
 import android.app.*
+import android.content.Context
 import android.content.Intent
 import android.os.IBinder
 import androidx.core.app.NotificationCompat
-import androidx.localbroadcastmanager.content.LocalBroadcastManager
+import java.util.concurrent.ExecutorService
+import java.util.concurrent.Executors
 
 class SearchService : Service() {
 
     companion object {
+        // صيغة المفتاح العام، نفس قيم PubkeyMode في native-lib.cpp
+        const val PUBKEY_COMPRESSED = 0
+        const val PUBKEY_UNCOMPRESSED = 1
+        const val PUBKEY_BOTH = 2
+
+        // الفاصل بين تحديثات كتلة الحالة من خيط التقارير الأصلي: إطار عرض واحد تقريبًا
+        const val PROGRESS_INTERVAL_MS = 16
+
+        // آخر بحث بدأ ولم ينته، لإعادته إن أعاد النظام تشغيل الخدمة (START_STICKY بلا Intent)
+        private const val PREFS_ACTIVE_SEARCH = "active_search"
+
+        // استدعاءات التحكم الأصلية خارج الخيط الرئيسي: الإيقاف ينتظر العمال حتى ثانية، والبدء يربط
+        // جدول المضاعفات أو يبنيه ويعيد قراءة السجل ويحجز ملف الاستئناف. خيط واحد للعملية كلها
+        // فتبقى الأوامر بترتيب وصولها (STOP ثم START، أو START ثم PAUSE)
+        private val control: ExecutorService = Executors.newSingleThreadExecutor()
+
         init {
             System.loadLibrary("native-lib")
         }
@@ -17,19 +35,68 @@ class SearchService : Service() {
     override fun onStartCommand(intent: Intent?, flags: Int, startId: Int): Int {
         when (intent?.action) {
             "START" -> {
-                val start = intent.getLongExtra("start", 0L)
-                val end = intent.getLongExtra("end", 1000000L)
+                // حدود 256-بت بالست عشري
+                val start = intent.getStringExtra("start") ?: "0"
+                val end = intent.getStringExtra("end") ?: "f4240"
                 val target = intent.getStringExtra("target") ?: ""
-                createNotification()
-                startSearchNative(start, end, target, CallbackImpl())
+                val pubkeyMode = intent.getIntExtra("pubkeyMode", PUBKEY_COMPRESSED)
+                val performanceCoresOnly = intent.getBooleanExtra("performanceCoresOnly", false)
+                val randomOrder = intent.getBooleanExtra("randomOrder", false)
+                val searchId = System.nanoTime()
+                getSharedPreferences(PREFS_ACTIVE_SEARCH, Context.MODE_PRIVATE).edit()
+                    .putLong("searchId", searchId)
+                    .putString("startHex", start)
+                    .putString("endHex", end)
+                    .putString("target", target)
+                    .putInt("pubkeyMode", pubkeyMode)
+                    .putBoolean("performanceCoresOnly", performanceCoresOnly)
+                    .putBoolean("randomOrder", randomOrder)
+                    .commit()
+                startSearch(searchId, start, end, target, pubkeyMode, performanceCoresOnly, randomOrder)
+            }
+            "PAUSE" -> control.execute { pauseSearchNative() }
+            "RESUME" -> control.execute { resumeSearchNative() }
+            "STOP" -> control.execute { stopSearchNative() }
+            // أعاد النظام تشغيل الخدمة بعد قتلها: نقطة الاستئناف الأصلية تتخطى ما فُحص
+            null -> {
+                val prefs = getSharedPreferences(PREFS_ACTIVE_SEARCH, Context.MODE_PRIVATE)
+                val target = prefs.getString("target", null)
+                val start = prefs.getString("startHex", null)
+                val end = prefs.getString("endHex", null)
+                if (target != null && start != null && end != null) {
+                    startSearch(
+                        prefs.getLong("searchId", 0L), start, end, target,
+                        prefs.getInt("pubkeyMode", PUBKEY_COMPRESSED),
+                        prefs.getBoolean("performanceCoresOnly", false),
+                        prefs.getBoolean("randomOrder", false)
+                    )
+                } else {
+                    stopSelf()
+                }
             }
-            "PAUSE" -> pauseSearchNative()
-            "RESUME" -> resumeSearchNative()
-            "STOP" -> stopSearchNative()
         }
         return START_STICKY
     }
 
+    private fun startSearch(
+        searchId: Long, start: String, end: String, target: String, pubkeyMode: Int, performanceCoresOnly: Boolean,
+        randomOrder: Boolean
+    ) {
+        createNotification()
+        val targets = splitTargets(target)
+        val dataDir = filesDir.absolutePath
+        control.execute {
+            startSearchNative(
+                start, end, targets, dataDir, pubkeyMode, performanceCoresOnly, randomOrder,
+                PROGRESS_INTERVAL_MS, CallbackImpl(searchId)
+            )
+        }
+    }
+
+    // العناوين مفصولة بأسطر أو مسافات أو فواصل، كما أُدخلت
+    private fun splitTargets(target: String): Array<String> =
+        target.split(Regex("[\\s,]+")).filter { it.isNotEmpty() }.toTypedArray()
+
     override fun onBind(intent: Intent?): IBinder? = null
 
     private fun createNotification() {
@@ -49,37 +116,29 @@ class SearchService : Service() {
         startForeground(1, notification)
     }
 
-    // Callback يمرر النتائج إلى MainActivity عبر Broadcast
-    inner class CallbackImpl {
-        fun onKeyFound(key: String) {
-            sendUpdate(foundKey = key)
-        }
-
-        fun onProgressUpdate(progress: Long) {
-            sendUpdate(progress = progress)
-        }
-
+    // ينهي الخدمة بعد انتهاء البحث. التقدم والمفتاح الموجود يقرؤهما SearchViewModel من كتلة الحالة
+    inner class CallbackImpl(private val searchId: Long) {
         fun onSearchFinished() {
-            sendUpdate(finished = true)
+            // البحث السابق ينتهي بعد أن يبدأ START التالي، فلا يمحو بياناته ولا يوقف الخدمة
+            val prefs = getSharedPreferences(PREFS_ACTIVE_SEARCH, Context.MODE_PRIVATE)
+            if (prefs.getLong("searchId", 0L) != searchId) return
+            prefs.edit().clear().apply()
             stopForeground(true)
             stopSelf()
         }
     }
 
-    private fun sendUpdate(
-        progress: Long = -1,
-        foundKey: String? = null,
-        finished: Boolean = false
-    ) {
-        val intent = Intent("SEARCH_UPDATE").apply {
-            if (progress >= 0) putExtra("progress", progress)
-            if (foundKey != null) putExtra("foundKey", foundKey)
-            putExtra("finished", finished)
-        }
-        sendBroadcast(intent)
-    }
-
-    external fun startSearchNative(start: Long, end: Long, target: String, callback: Any)
+    external fun startSearchNative(
+        start: String,
+        end: String,
+        targets: Array<String>,
+        dataDir: String,
+        pubkeyMode: Int,
+        performanceCoresOnly: Boolean,
+        randomOrder: Boolean,
+        progressIntervalMs: Int,
+        callback: Any
+    )
     external fun pauseSearchNative()
     external fun resumeSearchNative()
     external fun stopSearchNative()
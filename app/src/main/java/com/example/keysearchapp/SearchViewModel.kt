@@ -1,14 +1,17 @@
 package com.example.keysearchapp
 
+import android.view.Choreographer
 import androidx.lifecycle.LiveData
 import androidx.lifecycle.MutableLiveData
 import androidx.lifecycle.ViewModel
 
+// يقرأ كتلة الحالة الأصلية مرة كل إطار عرض ويحولها إلى LiveData، فلا callbacks ولا Broadcasts أثناء البحث
 class SearchViewModel : ViewModel() {
 
-    enum class State { STOPPED, SEARCHING, PAUSED, FOUND }
+    // IDLE: لم يبدأ أي بحث منذ تشغيل العملية
+    enum class State { IDLE, STOPPED, SEARCHING, PAUSED, FOUND }
 
-    private val _searchState = MutableLiveData(State.STOPPED)
+    private val _searchState = MutableLiveData(State.IDLE)
     val searchState: LiveData<State> = _searchState
 
     private val _progress = MutableLiveData(0)
@@ -20,64 +23,54 @@ class SearchViewModel : ViewModel() {
     private val _foundKey = MutableLiveData<String?>(null)
     val foundKey: LiveData<String?> = _foundKey
 
-    private var totalKeys: Long = 0
-    private var searchStartTime: Long = 0
+    private val status = SearchStatus()
+    private val choreographer = Choreographer.getInstance()
 
-    fun startSearch(totalKeysInRange: Long) {
-        totalKeys = totalKeysInRange
-        searchStartTime = System.currentTimeMillis()
-        _searchState.value = State.SEARCHING
-        _progress.value = 0
-        _statsText.value = "جاري البدء..."
-        _foundKey.value = null
+    private val frameCallback = object : Choreographer.FrameCallback {
+        override fun doFrame(frameTimeNanos: Long) {
+            if (NativeLoader.readStatus(status)) publish()
+            choreographer.postFrameCallback(this)
+        }
     }
 
-    fun forceStopState() {
-        _searchState.value = State.STOPPED
-        _statsText.value = "تم إيقاف البحث يدويًا."
+    init {
+        choreographer.postFrameCallback(frameCallback)
     }
 
-    fun onKeyFound(key: String) {
-        _searchState.value = State.FOUND
-        _foundKey.value = key
-        _progress.value = 100
-        _statsText.value = "✅ تم العثور على المفتاح!"
+    override fun onCleared() {
+        choreographer.removeFrameCallback(frameCallback)
     }
 
-    fun onProgressUpdate(keysChecked: Long) {
-        if (_searchState.value == State.SEARCHING || _searchState.value == State.PAUSED) {
-            if (totalKeys > 0) {
-                _progress.value = ((keysChecked * 100) / totalKeys).toInt()
-            }
-            val elapsedTimeSec = (System.currentTimeMillis() - searchStartTime) / 1000.0
-            if (elapsedTimeSec > 0) {
-                val keysPerSecond = keysChecked / elapsedTimeSec
-                _statsText.value = String.format(
-                    "%.0f مفتاح/ثانية | تم فحص: %d من %d",
-                    keysPerSecond, keysChecked, totalKeys
-                )
-            }
-        }
-    }
+    // لا يُستدعى إلا حين تغير sequence، فالإطارات دون تحديث لا تلمس LiveData
+    private fun publish() {
+        if (status.searchId == 0) return
 
-    fun setPaused(isPaused: Boolean) {
-        _searchState.value = if (isPaused) {
-            _statsText.value = "⏸ البحث متوقف مؤقتًا."
-            State.PAUSED
-        } else {
-            _statsText.value = "▶ البحث مستمر..."
-            State.SEARCHING
+        val state = when {
+            status.hitCount > 0 -> State.FOUND
+            status.state == NativeLoader.STATE_RUNNING -> State.SEARCHING
+            status.state == NativeLoader.STATE_PAUSED -> State.PAUSED
+            else -> State.STOPPED
         }
-    }
+        if (_searchState.value != state) _searchState.value = state
 
-    fun onSearchFinished() {
-        if (_searchState.value != State.FOUND) {
-            _searchState.value = State.STOPPED
-            if (_progress.value != 100) {
-                _statsText.value = "تم إيقاف البحث بواسطة المستخدم."
-            } else {
-                _statsText.value = "انتهى البحث: لم يتم العثور على المفتاح في هذا النطاق."
-            }
+        val percent = (status.coverage * 100).toInt()
+        if (_progress.value != percent) _progress.value = percent
+
+        val key = if (status.hitCount > 0) {
+            "0x" + status.foundKey.reversed().joinToString("") { String.format("%016x", it) }.trimStart('0')
+        } else null
+        if (_foundKey.value != key) _foundKey.value = key
+
+        val rate = String.format("%,.0f", status.keysPerSecond)
+        val perThread = (0 until status.workers).joinToString(" / ") {
+            String.format("%.0fk", status.workerRates[it] / 1000)
+        }
+        _statsText.value = when {
+            status.state == NativeLoader.STATE_IDLE && status.hitCount == 0 && status.coverage >= 1.0 ->
+                "انتهى البحث: لم يتم العثور على المفتاح في هذا النطاق. تم فحص: ${status.keysChecked} مفتاح"
+            status.state == NativeLoader.STATE_IDLE && status.hitCount == 0 ->
+                "تم إيقاف البحث. تم فحص: ${status.keysChecked} مفتاح"
+            else -> "تم فحص: ${status.keysChecked} مفتاح — $rate مفتاح/ث\n$perThread"
         }
     }
-}
\ No newline at end of file
+}
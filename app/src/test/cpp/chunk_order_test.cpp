@@ -0,0 +1,118 @@
+// ترتيب زيارة القطع العشوائي:
+//   - لأطوال ليست قوى 2 (ومنها 1 و 2 و 2^k ± 1 وأعداد أولية) وعدة مفاتيح، at() تبديل لـ [0, n):
+//     كل موضع يعطي قطعة داخل النطاق، وكل قطعة تُزار مرة واحدة بالضبط
+//   - مفتاحان مختلفان يعطيان ترتيبين مختلفين، والترتيب العشوائي ليس الخطي
+// ثم ما يضيفه الترتيب العشوائي لكل مفتاح: at() و reset (ضرب كامل k*G) في بداية كل قطعة بحجم القطعة
+// الافتراضي 16 دفعة × 1024، ومفاتيح/ث لمشي نفس القطع بالترتيب الخطي (مشي واحد متصل) وبالعشوائي
+
+#include "chunk_order.h"
+#include "pipeline_support.h"
+#include "test_support.h"
+
+#include <random>
+#include <vector>
+
+static void check_permutation(uint64_t n, uint64_t key) {
+    const ChunkOrder order(n, key);
+    std::vector<unsigned char> seen(n);
+    uint64_t out_of_range = 0, repeated = 0;
+    for (uint64_t p = 0; p < n; ++p) {
+        const uint64_t c = order.at(p);
+        if (c >= n) {
+            ++out_of_range;
+            continue;
+        }
+        repeated += seen[c];
+        seen[c] = 1;
+    }
+    CHECK(out_of_range == 0 && repeated == 0, "n=%llu key=%llx: %llu chunks out of range, %llu visited twice",
+          (unsigned long long)n, (unsigned long long)key, (unsigned long long)out_of_range,
+          (unsigned long long)repeated);
+}
+
+static void check_orders() {
+    std::mt19937_64 rng(19);
+    const uint64_t sizes[] = {1, 2, 3, 5, 7, 31, 33, 100, 255, 257, 1000, 4095, 4097, 65535, 65537, 999983, 1048577};
+    for (uint64_t n : sizes) {
+        for (uint64_t key : {(uint64_t)0, (uint64_t)1, (uint64_t)0x5eed, (uint64_t)rng(), (uint64_t)rng()}) {
+            check_permutation(n, key);
+        }
+    }
+
+    const uint64_t N = 10007;
+    const ChunkOrder a(N, 1), b(N, 2);
+    uint64_t same = 0, fixed = 0;
+    for (uint64_t p = 0; p < N; ++p) {
+        same += a.at(p) == b.at(p);
+        fixed += a.at(p) == p;
+    }
+    // تبديلان عشوائيان يتفقان في موضع واحد تقريبًا في المتوسط
+    CHECK(same < 20, "two keys give nearly the same order (%llu of %llu positions)", (unsigned long long)same,
+          (unsigned long long)N);
+    CHECK(fixed < 20, "random order keeps %llu of %llu chunks in place", (unsigned long long)fixed,
+          (unsigned long long)N);
+}
+
+// مفاتيح/ث لـ chunks قطعة متجاورة من first: بالترتيب الخطي مشي واحد، وإلا reset لكل قطعة
+static double walk_keys_per_second(SearchPipeline& pipeline, const ChunkOrder& order, uint64_t chunks,
+                                   uint64_t chunk_keys) {
+    const U256 first = u256_from_u64(0x10000000000ull);
+    std::vector<PipelineHit> hits;
+    double best = 0;
+    for (int rep = 0; rep < 3; ++rep) {
+        const double t0 = thread_cpu_seconds();
+        if (order.linear()) pipeline.reset(first);
+        for (uint64_t p = 0; p < chunks; ++p) {
+            if (!order.linear()) {
+                U256 base;
+                u256_add_u64(base, first, order.at(p) * chunk_keys);
+                pipeline.reset(base);
+            }
+            for (uint64_t k = 0; k < chunk_keys; k += pipeline.batch_size()) {
+                CHECK(!pipeline.run_batch(pipeline.batch_size(), hits), "unexpected hit in the benchmark range");
+            }
+        }
+        best = std::max(best, chunks * chunk_keys / (thread_cpu_seconds() - t0));
+    }
+    return best;
+}
+
+static void bench_orders(const GeneratorTable& table) {
+    const uint64_t N = 1 << 20;
+    const ChunkOrder order(N, 0x5eed);
+    uint64_t sink = 0;
+    double t0 = thread_cpu_seconds();
+    for (uint64_t p = 0; p < N; ++p) sink += order.at(p);
+    const double at_ns = (thread_cpu_seconds() - t0) * 1e9 / N;
+    CHECK(sink == N * (N - 1) / 2, "order over %llu chunks is not a permutation", (unsigned long long)N);
+
+    const uint64_t CHUNK_KEYS = 16 * 1024, CHUNKS = 16;
+    unsigned char digest[20];
+    memset(digest, 0x5a, sizeof(digest));
+    const TargetSpec spec = target_spec(TargetKind::KeyHash, digest);
+    auto targets = std::make_shared<const TargetSet>(&spec, 1);
+    SearchPipeline pipeline(table, 1024, PubkeyMode::Compressed, targets, simd_best_backend());
+    double linear = 0, random = 0;
+    for (int round = 0; round < 3; ++round) {
+        linear = std::max(linear, walk_keys_per_second(pipeline, ChunkOrder(), CHUNKS, CHUNK_KEYS));
+        random = std::max(random, walk_keys_per_second(pipeline, ChunkOrder(CHUNKS, 0x5eed), CHUNKS, CHUNK_KEYS));
+    }
+    // ما يضيفه الترتيب العشوائي فعلًا: at() و reset (ضرب كامل) لكل قطعة، وهو أصغر من ضجيج المقارنة الكاملة
+    const int RESETS = 2000;
+    t0 = thread_cpu_seconds();
+    for (int i = 0; i < RESETS; ++i) pipeline.reset(u256_from_u64(0x10000000000ull + (uint64_t)i * CHUNK_KEYS));
+    const double reset_ns = (thread_cpu_seconds() - t0) * 1e9 / RESETS;
+    const double extra_ns = (at_ns + reset_ns) / CHUNK_KEYS;
+    printf("per chunk: ChunkOrder::at %.1f ns, reset %.1f us -> %.2f ns per key at %llu keys per chunk "
+           "(%.2f%% of %.0f ns per key)\n",
+           at_ns, reset_ns / 1000, extra_ns, (unsigned long long)CHUNK_KEYS, 100 * extra_ns * linear / 1e9,
+           1e9 / linear);
+    printf("linear order %.0f keys/s, random order %.0f keys/s\n", linear, random);
+}
+
+int main() {
+    check_orders();
+    std::shared_ptr<const GeneratorTable> table = GeneratorTable::open_or_build("");
+    bench_orders(*table);
+    return test_result("chunk_order_test");
+}
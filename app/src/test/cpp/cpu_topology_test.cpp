@@ -0,0 +1,121 @@
+// cpu_topology_detect على أشجار sysfs مزيفة في مجلد مؤقت:
+//   - هاتف big.LITTLE (4 LITTLE + 3 big + prime) بحزمة واحدة و cluster_id لكل عنقود: الأسرع أولًا،
+//     أنوية الأداء big و prime فقط، والعنقودان مجموعتان مختلفتان
+//   - نفس الهاتف دون cpu_capacity: السعة من cpuinfo_max_freq
+//   - x86 بحزمتين و SMT و cluster_id واحد لكل الأنوية: الحزمتان لا تندمجان، والأنوية الفيزيائية قبل أشقائها
+//   - شجرة فارغة: hardware_concurrency() أنوية متساوية دون أرقام معالج
+
+#include "cpu_topology.h"
+#include "test_support.h"
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+struct FakeCpu {
+    int package;
+    int cluster;            // -1: بلا cluster_id
+    int core_id;
+    std::string siblings;
+    int capacity;           // 0: بلا cpu_capacity
+    long max_freq;
+};
+
+static void write_file(const std::string& path, const std::string& text) {
+    FILE* f = fopen(path.c_str(), "w");
+    CHECK(f != nullptr, "create %s", path.c_str());
+    if (f == nullptr) return;
+    fputs(text.c_str(), f);
+    fclose(f);
+}
+
+static std::string fake_sysfs(const std::string& root, const char* name, const std::vector<FakeCpu>& cpus) {
+    const std::string dir = root + "/" + name;
+    mkdir(dir.c_str(), 0700);
+    write_file(dir + "/online", "0-" + std::to_string(cpus.size() - 1) + "\n");
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        const FakeCpu& c = cpus[i];
+        const std::string cpu = dir + "/cpu" + std::to_string(i);
+        mkdir(cpu.c_str(), 0700);
+        mkdir((cpu + "/topology").c_str(), 0700);
+        mkdir((cpu + "/cpufreq").c_str(), 0700);
+        write_file(cpu + "/topology/physical_package_id", std::to_string(c.package) + "\n");
+        if (c.cluster >= 0) write_file(cpu + "/topology/cluster_id", std::to_string(c.cluster) + "\n");
+        write_file(cpu + "/topology/core_id", std::to_string(c.core_id) + "\n");
+        write_file(cpu + "/topology/thread_siblings_list", c.siblings + "\n");
+        if (c.capacity > 0) write_file(cpu + "/cpu_capacity", std::to_string(c.capacity) + "\n");
+        write_file(cpu + "/cpufreq/cpuinfo_max_freq", std::to_string(c.max_freq) + "\n");
+    }
+    return dir;
+}
+
+static std::vector<FakeCpu> phone(bool with_capacity) {
+    std::vector<FakeCpu> cpus;
+    for (int i = 0; i < 8; ++i) {
+        const bool little = i < 4, prime = i == 7;
+        const int capacity = little ? 325 : prime ? 1024 : 871;
+        const long freq = little ? 1800000 : prime ? 3200000 : 2800000;
+        cpus.push_back(FakeCpu{0, little ? 0 : 1, i, std::to_string(i), with_capacity ? capacity : 0, freq});
+    }
+    return cpus;
+}
+
+static void check_phone(const CpuTopology& topo, const char* what) {
+    CHECK(topo.cores.size() == 8, "%s: %zu cores", what, topo.cores.size());
+    if (topo.cores.size() != 8) return;
+    CHECK(topo.heterogeneous(), "%s: not heterogeneous", what);
+    CHECK(topo.cores[0].cpu == 7 && topo.cores[0].capacity == 1024, "%s: cpu%d first, expected the prime core",
+          what, topo.cores[0].cpu);
+    for (size_t i = 0; i < topo.cores.size(); ++i) {
+        const CpuCore& core = topo.cores[i];
+        const bool little = core.cpu < 4;
+        CHECK(little == (i >= 4), "%s: cpu%d at position %zu", what, core.cpu, i);
+        CHECK(topo.is_performance(core) == !little, "%s: cpu%d performance flag", what, core.cpu);
+        CHECK(core.smt_primary, "%s: cpu%d not an SMT primary", what, core.cpu);
+        // العنقودان داخل الحزمة الواحدة مجموعتان مختلفتان، وأنوية العنقود الواحد مجموعة واحدة
+        CHECK((core.package == topo.cores.back().package) == little, "%s: cpu%d in group %d", what, core.cpu,
+              core.package);
+    }
+}
+
+static void check_x86(const std::string& root) {
+    // حزمتان × نواتان × SMT: المعالجات 0-3 فيزيائية و 4-7 أشقاؤها. cluster_id = 0 في الحزمتين
+    std::vector<FakeCpu> cpus;
+    for (int i = 0; i < 8; ++i) {
+        const int physical = i % 4;
+        const std::string siblings = std::to_string(physical) + "," + std::to_string(physical + 4);
+        cpus.push_back(FakeCpu{physical / 2, 0, physical % 2, siblings, 0, 3600000});
+    }
+    const CpuTopology topo = cpu_topology_detect(fake_sysfs(root, "x86", cpus));
+    CHECK(topo.cores.size() == 8, "x86: %zu cores", topo.cores.size());
+    if (topo.cores.size() != 8) return;
+    CHECK(!topo.heterogeneous(), "x86: heterogeneous");
+    int package_of[8];
+    for (size_t i = 0; i < topo.cores.size(); ++i) {
+        const CpuCore& core = topo.cores[i];
+        package_of[core.cpu] = core.package;
+        CHECK(core.smt_primary == (i < 4) && core.smt_primary == (core.cpu < 4), "x86: cpu%d at position %zu",
+              core.cpu, i);
+        CHECK(topo.is_performance(core), "x86: cpu%d not a performance core", core.cpu);
+    }
+    CHECK(package_of[0] == package_of[1] && package_of[2] == package_of[3] && package_of[0] != package_of[2],
+          "x86: packages merged or split by cluster_id (%d %d %d %d)", package_of[0], package_of[1], package_of[2],
+          package_of[3]);
+    CHECK(package_of[4] == package_of[0] && package_of[6] == package_of[2], "x86: SMT sibling in another package");
+}
+
+int main() {
+    const std::string root = make_temp_dir("cpu_topology_test");
+    check_phone(cpu_topology_detect(fake_sysfs(root, "phone", phone(true))), "big.LITTLE");
+    check_phone(cpu_topology_detect(fake_sysfs(root, "phone_freq", phone(false))), "big.LITTLE by frequency");
+    check_x86(root);
+
+    const CpuTopology none = cpu_topology_detect(root + "/missing");
+    CHECK(!none.cores.empty() && none.cores[0].cpu == -1 && !none.heterogeneous(),
+          "missing sysfs: %zu cores, cpu %d", none.cores.size(), none.cores.empty() ? 0 : none.cores[0].cpu);
+
+    remove_tree(root);
+    return test_result("cpu_topology_test");
+}
@@ -0,0 +1,129 @@
+// الانعكاس المشترك ومشي المجموعات مقابل مراجع مستقلة:
+//   - fe_batch_inv لأطوال 1 و 2 وفردية و 1024: كل عنصر في معكوسه = 1، ورفض الدفعة التي فيها صفر دون تعديلها
+//   - كل نقطة يمشيها EcGroupWalk بأحجام 1 و 2 وفردية و 1024 تساوي مرجع OpenSSL لمفتاحها
+//     (EC_POINT_mul للبداية ثم EC_POINT_add)، عبر عدة مجموعات متتالية من بداية بعرض 256 بت
+//   - حواف المنحنى حيث ينهار الانعكاس المشترك: المركز عند iG وعند n - iG، ومجموعة تعبر رتبة المنحنى n
+// ثم مفاتيح/ث للبحث بأحجام مجموعات من 64 إلى 4096: أساس DEFAULT_GROUP_SIZE = 1024
+
+#include "ec_batch.h"
+#include "oracle.h"
+#include "pipeline_support.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const FieldElem ONE = {{1, 0, 0, 0}};
+
+static FieldElem random_fe(std::mt19937_64& rng) {
+    // أقل من p دائمًا: الكلمة العليا دون الحد
+    return FieldElem{{rng(), rng(), rng(), rng() >> 1}};
+}
+
+static void check_batch_inv(std::mt19937_64& rng) {
+    for (size_t n : {1, 2, 3, 7, 255, 1024}) {
+        std::vector<FieldElem> elems(n), inv(n), scratch(n);
+        for (FieldElem& e : elems) e = random_fe(rng);
+        inv = elems;
+        CHECK(fe_batch_inv(inv.data(), n, scratch.data()), "n=%zu: batch inverse failed", n);
+        for (size_t i = 0; i < n; ++i) {
+            FieldElem product;
+            fe_mul(product, elems[i], inv[i]);
+            CHECK(fe_equal(product, ONE), "n=%zu: element %zu times its inverse is not 1", n, i);
+        }
+
+        // صفر في أي موضع: لا انعكاس ولا تعديل
+        inv = elems;
+        inv[rng() % n] = FieldElem{{0, 0, 0, 0}};
+        std::vector<FieldElem> before = inv;
+        CHECK(!fe_batch_inv(inv.data(), n, scratch.data()), "n=%zu: batch with a zero was inverted", n);
+        CHECK(memcmp(inv.data(), before.data(), n * sizeof(FieldElem)) == 0, "n=%zu: rejected batch was modified",
+              n);
+    }
+}
+
+// groups مجموعة متتالية من start، وكل نقطة مقابل OpenSSL لمفتاحها mod n. المفتاح n نفسه
+// (نقطة اللانهاية) ليس له إحداثيات، ولا يصل إليه البحث لأن نهاية النطاق دون n
+static void check_walk_from(const GeneratorTable& table, size_t group, const U256& start, int groups,
+                            const char* what) {
+    EcGroupWalk walk(table, group);
+    walk.reset(start);
+    OracleWalk oracle(start);
+    std::vector<FieldElem> xs(group), ys(group);
+    for (int g = 0; g < groups; ++g) {
+        walk.next_group(xs.data(), ys.data());
+        for (size_t j = 0; j < group; ++j, oracle.next()) {
+            unsigned char ours[65] = {0x04}, want[65];
+            if (!oracle.uncompressed(want)) continue;
+            fe_to_be_bytes(xs[j], ours + 1);
+            fe_to_be_bytes(ys[j], ours + 33);
+            CHECK(memcmp(ours, want, 65) == 0, "%s, group size %zu: point %zu of group %d differs from OpenSSL", what,
+                  group, j, g);
+        }
+    }
+}
+
+static void check_group_walk(const GeneratorTable& table, std::mt19937_64& rng) {
+    for (size_t group : {1, 2, 3, 7, 33, 64, 1023, 1024}) {
+        check_walk_from(table, group, U256{{rng(), rng(), rng(), rng() >> 2}}, 3, "random start");
+    }
+}
+
+// المركز C = start + group_size/2. الانعكاس المشترك ينهار إن كان C = ±iG (i <= group_size/2)
+// أو C = -group_size*G، فيمشي next_group تلك المجموعة بالجمع العادي
+static void check_curve_edges(const GeneratorTable& table) {
+    for (size_t group : {1, 2, 3, 7, 1024}) {
+        const size_t half = group / 2, upper = group - 1 - half;
+        // بداية المنحنى: C = (half + 1)G .. ، ومنها C = group_size*G حيث الانتقال إلى المركز التالي مضاعفة
+        for (uint64_t first = 1; first <= group + 2; first += group > 64 ? 511 : 1) {
+            check_walk_from(table, group, u256_from_u64(first), 3, "centre at iG");
+        }
+        check_walk_from(table, group, u256_from_u64(group - half), 3, "centre at group_size*G");
+
+        // نهاية المنحنى: C = n - iG. لكل i <= upper تضم المجموعة المفتاح n، وما بعده يعود إلى 1G، 2G، ...
+        for (uint64_t i : {(uint64_t)0, (uint64_t)1, (uint64_t)half, (uint64_t)upper, (uint64_t)group,
+                           (uint64_t)group + 1}) {
+            U256 start;
+            u256_sub(start, SECP256K1_N, u256_from_u64(i + half));
+            check_walk_from(table, group, start, 3, "centre at n-iG");
+        }
+        // مجموعة تعبر n من منتصفها بعد مجموعتين عاديتين
+        U256 start;
+        u256_sub(start, SECP256K1_N, u256_from_u64(2 * group + upper));
+        check_walk_from(table, group, start, 4, "group crossing n");
+    }
+}
+
+static void bench_group_sizes(const GeneratorTable& table) {
+    const uint64_t KEYS = 1 << 17;
+    unsigned char digest[20];
+    memset(digest, 0x5a, sizeof(digest));
+    const std::vector<TargetSpec> specs = {target_spec(TargetKind::KeyHash, digest)};
+    // الأحجام بالتناوب في عدة جولات وأفضل قيمة لكل حجم، حتى لا يقع ضجيج الجهاز على حجم واحد
+    const size_t SIZES[] = {64, 128, 256, 512, 1024, 2048, 4096};
+    double rates[7] = {0};
+    for (int round = 0; round < 3; ++round) {
+        for (size_t i = 0; i < 7; ++i) {
+            rates[i] = std::max(rates[i], keys_per_second(table, PubkeyMode::Compressed, specs, KEYS,
+                                                          default_pipeline_stages(), SIZES[i]));
+        }
+    }
+    double best = 0, chosen = 0;
+    for (size_t i = 0; i < 7; ++i) {
+        printf("group size %4zu: %8.0f keys/s\n", SIZES[i], rates[i]);
+        best = std::max(best, rates[i]);
+        if (SIZES[i] == 1024) chosen = rates[i];
+    }
+    printf("group size 1024 at %.0f%% of the best size\n", 100 * chosen / best);
+}
+
+int main() {
+    std::mt19937_64 rng(6);
+    std::shared_ptr<const GeneratorTable> table = GeneratorTable::open_or_build("");
+    check_batch_inv(rng);
+    check_group_walk(*table, rng);
+    check_curve_edges(*table);
+    bench_group_sizes(*table);
+    return test_result("ec_batch_test");
+}
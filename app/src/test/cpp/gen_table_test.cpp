@@ -0,0 +1,108 @@
+// ملف جدول المضاعفات في مجلد مؤقت، كل فتح في عملية فرعية حتى لا يعيد المخزن داخل العملية نفس الجدول:
+//   - الفتح الأول يبني الملف ويربطه، والثاني يربطه كما هو دون بناء (نفس inode)
+//   - المضاعفات وعينة من كل نافذة و k*G بالجدول تساوي EC_POINT_mul
+//   - بايت مقلوب في النقاط أو ملف مقطوع: عدم تطابق CRC أو الحجم يعيد البناء، والجدول الناتج صحيح
+// مع زمن البناء مقابل زمن الربط
+
+#include "gen_table.h"
+#include "oracle.h"
+#include "test_support.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+
+static std::string table_path(const std::string& dir) { return dir + "/secp256k1_gtable.bin"; }
+
+static ino_t inode_of(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_ino : 0;
+}
+
+static bool same_point(const AffinePoint& p, const U256& k) {
+    unsigned char ours[65] = {0x04}, want[65];
+    fe_to_be_bytes(p.x, ours + 1);
+    fe_to_be_bytes(p.y, ours + 33);
+    oracle_pubkey(k, false, want);
+    return !p.infinity && memcmp(ours, want, 65) == 0;
+}
+
+static void check_entries(const GeneratorTable& table) {
+    // المضاعفات كلها بمشي OpenSSL
+    OracleWalk oracle(u256_from_u64(1));
+    for (size_t i = 0; i < GEN_TABLE_MULTIPLES; ++i, oracle.next()) {
+        unsigned char ours[65] = {0x04}, want[65];
+        oracle.uncompressed(want);
+        fe_to_be_bytes(table.multiples()[i].x, ours + 1);
+        fe_to_be_bytes(table.multiples()[i].y, ours + 33);
+        CHECK(memcmp(ours, want, 65) == 0, "multiple %zu differs from OpenSSL", i + 1);
+    }
+    // window(j)[v - 1] = v * 2^(8j) * G
+    for (size_t j = 0; j < GEN_TABLE_WINDOWS; ++j) {
+        for (unsigned v : {1u, 2u, 3u, 128u, 254u, 255u}) {
+            U256 k = U256{};
+            k.d[j / 8] = (uint64_t)v << ((j % 8) * 8);
+            CHECK(same_point(table.window(j)[v - 1], k), "window %zu entry %u differs from OpenSSL", j, v);
+        }
+    }
+    std::mt19937_64 rng(8);
+    for (int i = 0; i < 32; ++i) {
+        const U256 k = {{rng(), rng(), rng(), rng() >> 1}};
+        AffinePoint p;
+        table.mul_generator(p, k);
+        CHECK(same_point(p, k), "mul_generator differs from OpenSSL for k.d[0]=%016llx", (unsigned long long)k.d[0]);
+    }
+}
+
+// يفتح الجدول في عملية فرعية ويتحقق منه، ويطبع زمن الفتح
+static void open_in_child(const std::string& dir, const char* what) {
+    in_child([&] {
+        const auto t0 = std::chrono::steady_clock::now();
+        std::shared_ptr<const GeneratorTable> table = GeneratorTable::open_or_build(dir);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        printf("%-24s %7.2f ms\n", what, ms);
+        CHECK(table->mapped(), "%s: table not mapped from the file", what);
+        check_entries(*table);
+    });
+}
+
+static void flip_byte(const std::string& path, off_t offset) {
+    int fd = open(path.c_str(), O_RDWR);
+    unsigned char b = 0;
+    CHECK(pread(fd, &b, 1, offset) == 1, "read %s", path.c_str());
+    b ^= 0x01;
+    CHECK(pwrite(fd, &b, 1, offset) == 1, "write %s", path.c_str());
+    close(fd);
+}
+
+int main() {
+    const std::string dir = make_temp_dir("gen_table_test");
+    const std::string path = table_path(dir);
+
+    open_in_child(dir, "build");
+    const ino_t built = inode_of(path);
+    CHECK(built != 0, "table file not written");
+    struct stat st;
+    stat(path.c_str(), &st);
+
+    open_in_child(dir, "map");
+    CHECK(inode_of(path) == built, "valid table was rebuilt instead of mapped");
+
+    // بايت في منتصف النقاط: الترويسة سليمة و CRC لا يطابق
+    flip_byte(path, st.st_size / 2);
+    open_in_child(dir, "rebuild after CRC error");
+    const ino_t rebuilt = inode_of(path);
+    CHECK(rebuilt != built, "corrupted table was not rebuilt");
+
+    CHECK(truncate(path.c_str(), st.st_size - 1) == 0, "truncate %s", path.c_str());
+    open_in_child(dir, "rebuild after truncation");
+    CHECK(inode_of(path) != rebuilt, "truncated table was not rebuilt");
+    struct stat after;
+    CHECK(stat(path.c_str(), &after) == 0 && after.st_size == st.st_size, "rebuilt table has the wrong size");
+
+    remove_tree(dir);
+    return test_result("gen_table_test");
+}
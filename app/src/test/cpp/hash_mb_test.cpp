@@ -0,0 +1,123 @@
+// sha256_mb و hash160_mb لكل نواة يدعمها المعالج (المحمولة، SSE4.1، AVX2، NEON) مطابقة بتًا ببت
+// لـ OpenSSL (SHA256، ثم RIPEMD160 بعده عبر EVP)، لكل الأطوال حتى 119 بايت وأعداد رسائل فردية
+// وليست من مضاعفات المسارات. ثم معدل الرسائل لكل نواة مقابل OpenSSL بأطوال البحث (32 و 33 و 65)
+#include "hash_mb.h"
+#include "oracle.h"
+#include "test_support.h"
+
+#include <openssl/sha.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const SimdBackend BACKENDS[] = {SimdBackend::Scalar, SimdBackend::SSE41, SimdBackend::AVX2, SimdBackend::NEON};
+
+static void check_identity(SimdBackend backend, std::mt19937& rng) {
+    size_t compared = 0;
+    for (size_t len = 0; len <= 119; ++len) {
+        for (size_t count : {1, 3, 8, 13, 64}) {
+            std::vector<unsigned char> data(count * len + 1);
+            for (unsigned char& c : data) c = (unsigned char)rng();
+            std::vector<const unsigned char*> msgs(count);
+            for (size_t i = 0; i < count; ++i) msgs[i] = &data[i * len];
+            std::vector<unsigned char> digests(count * 32);
+            sha256_mb(backend, msgs.data(), len, count, (unsigned char (*)[32])digests.data());
+            for (size_t i = 0; i < count; ++i) {
+                unsigned char want[32];
+                SHA256(msgs[i], len, want);
+                CHECK(memcmp(want, &digests[i * 32], 32) == 0, "%s len=%zu count=%zu msg=%zu",
+                      simd_backend_name(backend), len, count, i);
+                ++compared;
+            }
+        }
+    }
+    printf("%-7s %d lanes: %zu digests compared with OpenSSL\n", simd_backend_name(backend),
+           simd_backend_lanes(backend), compared);
+}
+
+// RIPEMD-160 متعدد المسارات لا يُستدعى إلا بعد SHA-256 في الخط نفسه، فيُختبر عبر hash160_mb.
+// أطوال البحث (22 للسكربت، 32، 33، 65) مع كل الأطوال الأخرى
+static void check_hash160(SimdBackend backend, std::mt19937& rng) {
+    size_t compared = 0;
+    for (size_t len = 0; len <= 119; ++len) {
+        for (size_t count : {1, 3, 5, 7, 9, 13, 64}) {
+            std::vector<unsigned char> data(count * len + 1);
+            for (unsigned char& c : data) c = (unsigned char)rng();
+            std::vector<const unsigned char*> msgs(count);
+            for (size_t i = 0; i < count; ++i) msgs[i] = &data[i * len];
+            std::vector<unsigned char> digests(count * 20);
+            hash160_mb(backend, msgs.data(), len, count, (unsigned char (*)[20])digests.data());
+            for (size_t i = 0; i < count; ++i) {
+                unsigned char want[20];
+                oracle_hash160(msgs[i], len, want);
+                CHECK(memcmp(want, &digests[i * 20], 20) == 0, "%s hash160 len=%zu count=%zu msg=%zu",
+                      simd_backend_name(backend), len, count, i);
+                ++compared;
+            }
+        }
+    }
+    printf("%-7s %d lanes: %zu hash160 digests compared with OpenSSL\n", simd_backend_name(backend),
+           simd_backend_lanes(backend), compared);
+}
+
+// أفضل 5 تكرارات بوقت المعالج، مليون رسالة/ث
+template <class Fn>
+static double rate(size_t messages, Fn fn) {
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        double t0 = thread_cpu_seconds();
+        fn();
+        best = std::min(best, thread_cpu_seconds() - t0);
+    }
+    return messages / best / 1e6;
+}
+
+int main() {
+    std::mt19937 rng(1);
+    for (SimdBackend backend : BACKENDS) {
+        if (!simd_backend_available(backend)) {
+            printf("%-7s not available on this CPU, skipped\n", simd_backend_name(backend));
+            continue;
+        }
+        check_identity(backend, rng);
+        check_hash160(backend, rng);
+    }
+
+    const size_t N = 1024, ITER = 200;
+    for (size_t len : {32, 33, 65}) {
+        std::vector<unsigned char> data(N * len);
+        for (unsigned char& c : data) c = (unsigned char)rng();
+        std::vector<const unsigned char*> msgs(N);
+        for (size_t i = 0; i < N; ++i) msgs[i] = &data[i * len];
+        std::vector<unsigned char> digests(N * 32);
+        unsigned char (*out)[32] = (unsigned char (*)[32])digests.data();
+        printf("len %zu: OpenSSL %.2f Mmsg/s", len, rate(N * ITER, [&] {
+            for (size_t it = 0; it < ITER; ++it)
+                for (size_t i = 0; i < N; ++i) SHA256(msgs[i], len, out[i]);
+        }));
+        for (SimdBackend backend : BACKENDS) {
+            if (!simd_backend_available(backend)) continue;
+            printf(", %s x%d %.2f", simd_backend_name(backend), simd_backend_lanes(backend), rate(N * ITER, [&] {
+                for (size_t it = 0; it < ITER; ++it) sha256_mb(backend, msgs.data(), len, N, out);
+            }));
+        }
+        printf("\n");
+
+        std::vector<unsigned char> h160(N * 20);
+        unsigned char (*out160)[20] = (unsigned char (*)[20])h160.data();
+        printf("len %zu hash160: OpenSSL %.2f Mmsg/s", len, rate(N * ITER / 4, [&] {
+            for (size_t it = 0; it < ITER / 4; ++it)
+                for (size_t i = 0; i < N; ++i) oracle_hash160(msgs[i], len, out160[i]);
+        }));
+        for (SimdBackend backend : BACKENDS) {
+            if (!simd_backend_available(backend)) continue;
+            printf(", %s x%d %.2f", simd_backend_name(backend), simd_backend_lanes(backend), rate(N * ITER, [&] {
+                for (size_t it = 0; it < ITER; ++it) hash160_mb(backend, msgs.data(), len, N, out160);
+            }));
+        }
+        printf("\n");
+    }
+    return test_result("hash_mb_test");
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// بديل <android/log.h> لبناء الاختبارات على المضيف: السجل إلى stderr
+
+#include <cstdio>
+
+#define ANDROID_LOG_INFO 4
+#define ANDROID_LOG_WARN 5
+#define ANDROID_LOG_ERROR 6
+#define __android_log_print(prio, tag, ...) \
+    (fprintf(stderr, "[%s] ", tag), fprintf(stderr, __VA_ARGS__), fprintf(stderr, "\n"))
@@ -0,0 +1,114 @@
+#pragma once
+
+// المراجع المستقلة عن المحرك من OpenSSL: k*G بـ EC_POINT_mul، و hash160 بـ SHA-256 ثم RIPEMD-160
+// عبر EVP (الدوال المباشرة مهملة في OpenSSL 3)، ومفتاح P2TR الناتج بتعريف BIP-341 مباشرة
+
+#include "uint256.h"
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+
+#include <cstddef>
+#include <cstring>
+
+// k*G مسلسلًا بـ 33 بايت (compressed) أو 65
+static inline void oracle_pubkey(const U256& k, bool compressed, unsigned char* out) {
+    static EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+    BN_CTX* ctx = BN_CTX_new();
+    unsigned char be[32];
+    u256_to_be_bytes(k, be);
+    BIGNUM* scalar = BN_bin2bn(be, 32, nullptr);
+    EC_POINT* point = EC_POINT_new(group);
+    EC_POINT_mul(group, point, scalar, nullptr, nullptr, ctx);
+    EC_POINT_point2oct(group, point, compressed ? POINT_CONVERSION_COMPRESSED : POINT_CONVERSION_UNCOMPRESSED, out,
+                       compressed ? 33 : 65, ctx);
+    EC_POINT_free(point);
+    BN_free(scalar);
+    BN_CTX_free(ctx);
+}
+
+static inline void oracle_sha256(const unsigned char* msg, size_t len, unsigned char out[32]) {
+    EVP_Digest(msg, len, out, nullptr, EVP_sha256(), nullptr);
+}
+
+static inline void oracle_hash160(const unsigned char* msg, size_t len, unsigned char out[20]) {
+    unsigned char sha[32];
+    oracle_sha256(msg, len, sha);
+    EVP_Digest(sha, sizeof(sha), out, nullptr, EVP_ripemd160(), nullptr);
+}
+
+// hash160 لمفتاح k بصيغته المضغوطة أو الكاملة
+static inline void oracle_key_hash(const U256& k, bool compressed, unsigned char out[20]) {
+    unsigned char pubkey[65];
+    oracle_pubkey(k, compressed, pubkey);
+    oracle_hash160(pubkey, compressed ? 33 : 65, out);
+}
+
+// tagged_hash("TapTweak", x) كاملًا، بلا حالة وسيطة
+static inline void oracle_tap_tweak(const unsigned char x[32], unsigned char out[32]) {
+    unsigned char msg[96];
+    oracle_sha256(reinterpret_cast<const unsigned char*>("TapTweak"), 8, msg);
+    memcpy(msg + 32, msg, 32);
+    memcpy(msg + 64, x, 32);
+    oracle_sha256(msg, sizeof(msg), out);
+}
+
+// BIP-86: P = k*G بـ y زوجي (أو -P)، ثم Q = P + H_TapTweak(P.x)*G، و x لـ Q
+static inline void oracle_taproot_output(const U256& k, unsigned char out[32]) {
+    static EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+    BN_CTX* ctx = BN_CTX_new();
+    unsigned char be[32], pubkey[33], tweak[32];
+    u256_to_be_bytes(k, be);
+    BIGNUM* scalar = BN_bin2bn(be, 32, nullptr);
+    EC_POINT* p = EC_POINT_new(group);
+    EC_POINT_mul(group, p, scalar, nullptr, nullptr, ctx);
+    EC_POINT_point2oct(group, p, POINT_CONVERSION_COMPRESSED, pubkey, sizeof(pubkey), ctx);
+    if (pubkey[0] == 0x03) EC_POINT_invert(group, p, ctx);
+    oracle_tap_tweak(pubkey + 1, tweak);
+    BIGNUM* t = BN_bin2bn(tweak, 32, nullptr);
+    BIGNUM* one = BN_new();
+    BN_one(one);
+    EC_POINT* q = EC_POINT_new(group);
+    EC_POINT_mul(group, q, t, p, one, ctx);
+    EC_POINT_point2oct(group, q, POINT_CONVERSION_COMPRESSED, pubkey, sizeof(pubkey), ctx);
+    memcpy(out, pubkey + 1, 32);
+    EC_POINT_free(q);
+    EC_POINT_free(p);
+    BN_free(one);
+    BN_free(t);
+    BN_free(scalar);
+    BN_CTX_free(ctx);
+}
+
+// k*G ثم (k+1)*G، ... بـ EC_POINT_add لمشي طويل دون ضرب كامل لكل مفتاح، ويعبر اللانهاية عند k = n
+class OracleWalk {
+public:
+    explicit OracleWalk(const U256& k) : group_(EC_GROUP_new_by_curve_name(NID_secp256k1)), ctx_(BN_CTX_new()) {
+        unsigned char be[32];
+        u256_to_be_bytes(k, be);
+        BIGNUM* scalar = BN_bin2bn(be, 32, nullptr);
+        point_ = EC_POINT_new(group_);
+        EC_POINT_mul(group_, point_, scalar, nullptr, nullptr, ctx_);
+        BN_free(scalar);
+    }
+    ~OracleWalk() {
+        EC_POINT_free(point_);
+        BN_CTX_free(ctx_);
+        EC_GROUP_free(group_);
+    }
+    OracleWalk(const OracleWalk&) = delete;
+    OracleWalk& operator=(const OracleWalk&) = delete;
+
+    // المفتاح الحالي بـ 65 بايت، false عند اللانهاية
+    bool uncompressed(unsigned char out[65]) const {
+        return EC_POINT_point2oct(group_, point_, POINT_CONVERSION_UNCOMPRESSED, out, 65, ctx_) == 65;
+    }
+    void next() { EC_POINT_add(group_, point_, point_, EC_GROUP_get0_generator(group_), ctx_); }
+
+private:
+    EC_GROUP* group_;
+    BN_CTX* ctx_;
+    EC_POINT* point_;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+// SearchPipeline مباشرة في الاختبارات: كل المطابقات على نطاق 64-بت، والمسار العام run_stages
+// بمراحل تساوي الافتراضية سلوكًا لكنها ليست هي (فلا تُختار النواة المخصصة)، ومعدل المفاتيح لنطاق
+
+#include "gen_table.h"
+#include "hash_mb.h"
+#include "search_pipeline.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct RangeHit {
+    uint64_t key;
+    std::string format;
+    size_t target;
+
+    bool operator<(const RangeHit& o) const {
+        return std::tie(key, format, target) < std::tie(o.key, o.format, o.target);
+    }
+    bool operator==(const RangeHit& o) const { return key == o.key && format == o.format && target == o.target; }
+};
+
+static size_t generic_match(const SearchBatch& batch, TargetKind kind, size_t from, const TargetSet& targets) {
+    const unsigned char* digests = batch.digests_of(kind);
+    const size_t len = target_digest_len(kind);
+    for (size_t j = from; j < batch.count; ++j) {
+        if (targets.find(kind, &digests[j * len]) >= 0) return j;
+    }
+    return batch.count;
+}
+
+static inline PipelineStages generic_stages() {
+    PipelineStages stages = default_pipeline_stages();
+    stages.match = generic_match;
+    return stages;
+}
+
+// كل المطابقات في count مفتاحًا من first، و key في كل مطابقة إزاحتها عن first
+static inline std::vector<RangeHit> pipeline_hits(SearchPipeline& pipeline, const U256& first, uint64_t count) {
+    std::vector<RangeHit> out;
+    std::vector<PipelineHit> hits;
+    pipeline.reset(first);
+    for (uint64_t offset = 0; offset < count; offset += pipeline.batch_size()) {
+        const uint64_t left = count - offset;
+        if (!pipeline.run_batch(left < pipeline.batch_size() ? left : pipeline.batch_size(), hits)) continue;
+        for (const PipelineHit& hit : hits) out.push_back(RangeHit{offset + hit.index, hit.format, hit.target});
+    }
+    return out;
+}
+
+// كل المطابقات في [first, last] بترتيب المفاتيح
+static inline std::vector<RangeHit> pipeline_hits(SearchPipeline& pipeline, uint64_t first, uint64_t last) {
+    std::vector<RangeHit> out = pipeline_hits(pipeline, u256_from_u64(first), last - first + 1);
+    for (RangeHit& hit : out) hit.key += first;
+    return out;
+}
+
+static inline TargetSpec target_spec(TargetKind kind, const unsigned char* digest) {
+    TargetSpec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.kind = kind;
+    memcpy(spec.digest, digest, target_digest_len(kind));
+    return spec;
+}
+
+// مفاتيح/ث بوقت المعالج لنطاق ثابت بلا مطابقة، أفضل 3 تكرارات
+static inline double keys_per_second(const GeneratorTable& table, PubkeyMode mode,
+                                     const std::vector<TargetSpec>& specs, uint64_t keys,
+                                     const PipelineStages& stages = default_pipeline_stages(),
+                                     size_t group_size = 1024) {
+    auto targets = std::make_shared<const TargetSet>(specs.data(), specs.size());
+    SearchPipeline pipeline(table, group_size, mode, targets, simd_best_backend(), stages);
+    const uint64_t first = 0x10000000000ull;
+    double best = 0;
+    for (int rep = 0; rep < 3; ++rep) {
+        const double t0 = thread_cpu_seconds();
+        std::vector<RangeHit> hits = pipeline_hits(pipeline, first, first + keys - 1);
+        best = std::max(best, keys / (thread_cpu_seconds() - t0));
+        CHECK(hits.empty(), "unexpected hit in the benchmark range");
+    }
+    return best;
+}
@@ -0,0 +1,132 @@
+// RangeScheduler بخيوط حقيقية بأوزان غير متساوية (نوى كبيرة وصغيرة وخيط بوزن 0):
+//   - القطع تغطي [start, end] متجاورة بلا فجوة، والأخيرة أقصر، وكل قطعة تُسلَّم مرة واحدة بالضبط
+//     بالترتيب الخطي والعشوائي، فكل مفتاح يُسلَّم مرة واحدة
+// ثم زمن البحث وذيله (آخر خيط ينتهي بعد أول خيط) لنطاق ثابت: شرائح ثابتة متساوية كما كان قبل
+// السرقة، مقابل RangeScheduler بأوزان متساوية وبالأوزان المقاسة. تكلفة القطعة نوم بطول 1/الوزن،
+// فلا يعتمد القياس على عدد نوى الجهاز
+
+#include "range_scheduler.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 4 نوى كبيرة وأربع صغيرة أبطأ بأربع مرات، وخيط مستبعد (performanceCoresOnly)
+static const std::vector<double> WEIGHTS = {4, 4, 4, 4, 1, 1, 1, 1, 0};
+static const uint64_t MAX_GRAIN = 4;
+
+static void check_chunks_tile_range(const RangeScheduler& s, const U256& start, const U256& end) {
+    U256 next = start;
+    for (uint64_t i = 0; i < s.chunk_count(); ++i) {
+        const KeyChunk c = s.chunk(i);
+        CHECK(u256_cmp(c.first, next) == 0, "chunk %llu does not start right after chunk %llu",
+              (unsigned long long)i, (unsigned long long)i - 1);
+        CHECK(u256_cmp(c.first, c.last) <= 0, "chunk %llu is empty", (unsigned long long)i);
+        CHECK(s.chunk_index(c.first) == i && s.chunk_index(c.last) == i, "chunk_index of chunk %llu",
+              (unsigned long long)i);
+        u256_add_u64(next, c.last, 1);
+    }
+    CHECK(u256_cmp(s.chunk(s.chunk_count() - 1).last, end) == 0, "last chunk does not end at the range end");
+}
+
+static void check_exactly_once(const ChunkOrder& order, const char* what) {
+    // نطاق بعرض 256 بت ينتهي بقطعة ناقصة
+    const U256 start = {{0xfffffffffffff000ull, 0x0123456789abcdefull, 0, 0x4000000000000000ull}};
+    const uint64_t CHUNK = 4096, CHUNKS = 3001;
+    U256 end;
+    u256_add_u64(end, start, CHUNK * (CHUNKS - 1) + 123);
+    RangeScheduler s(start, end, u256_from_u64(CHUNK), WEIGHTS, MAX_GRAIN, order);
+    CHECK(s.chunk_count() == CHUNKS, "%s: %llu chunks, expected %llu", what, (unsigned long long)s.chunk_count(),
+          (unsigned long long)CHUNKS);
+    check_chunks_tile_range(s, start, end);
+
+    std::vector<std::atomic<int>> handed(CHUNKS);
+    std::vector<uint64_t> taken(WEIGHTS.size());
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < WEIGHTS.size(); ++w) {
+        threads.emplace_back([&, w] {
+            ChunkSpan span;
+            while (s.next_span(w, span)) {
+                for (uint64_t p = 0; p < span.count; ++p) handed[s.chunk_at(span.first + p)]++;
+                taken[w] += span.count;
+                // الخيوط البطيئة تتأخر فتُسرق شرائحها
+                if (WEIGHTS[w] < 4) std::this_thread::sleep_for(std::chrono::microseconds(200));
+                else std::this_thread::yield();
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+
+    size_t missing = 0, repeated = 0;
+    for (const std::atomic<int>& n : handed) {
+        missing += n == 0;
+        repeated += n > 1;
+    }
+    CHECK(missing == 0 && repeated == 0, "%s: %zu chunks never handed out, %zu handed out more than once", what,
+          missing, repeated);
+    CHECK(taken.back() == 0, "%s: worker with weight 0 took %llu chunks", what, (unsigned long long)taken.back());
+    for (size_t w = 0; w + 1 < WEIGHTS.size(); ++w) {
+        CHECK(taken[w] > 0, "%s: worker %zu took no chunks", what, w);
+    }
+}
+
+struct TailTiming {
+    double total_ms;
+    double tail_ms;     // أول خيط ينتهي حتى آخر خيط
+};
+
+// كل خيط ينام 1/الوزن ms لكل قطعة. static_slices: كل خيط مشارك يمشي شريحة متساوية ثابتة
+static TailTiming run_fixed_range(const std::vector<double>& weights, bool static_slices) {
+    const uint64_t CHUNKS = 480;
+    RangeScheduler s(u256_from_u64(1), u256_from_u64(CHUNKS * 1024), u256_from_u64(1024), weights, MAX_GRAIN);
+    size_t active = 0;
+    for (double w : WEIGHTS) active += w > 0;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    std::vector<double> finished;
+    std::mutex finished_mutex;
+    std::vector<std::thread> threads;
+    size_t slot = 0;
+    for (size_t w = 0; w < WEIGHTS.size(); ++w) {
+        if (WEIGHTS[w] <= 0) continue;
+        const size_t index = slot++;
+        threads.emplace_back([&, w, index] {
+            const auto per_chunk = std::chrono::microseconds((int64_t)(1000 / WEIGHTS[w]));
+            if (static_slices) {
+                for (uint64_t i = index * CHUNKS / active; i < (index + 1) * CHUNKS / active; ++i) {
+                    std::this_thread::sleep_for(per_chunk);
+                }
+            } else {
+                ChunkSpan span;
+                while (s.next_span(w, span)) std::this_thread::sleep_for(per_chunk * span.count);
+            }
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            std::lock_guard<std::mutex> lock(finished_mutex);
+            finished.push_back(ms);
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    std::sort(finished.begin(), finished.end());
+    return TailTiming{finished.back(), finished.back() - finished.front()};
+}
+
+static void bench_tail_latency() {
+    // المثالي: 480 قطعة على سرعة كلية 4*4 + 4*1 = 20 قطعة/ms = 24 ms
+    const TailTiming before = run_fixed_range(WEIGHTS, true);
+    const TailTiming equal = run_fixed_range(std::vector<double>(WEIGHTS.size(), 1.0), false);
+    const TailTiming weighted = run_fixed_range(WEIGHTS, false);
+    printf("fixed slices:            total %6.1f ms, tail %6.1f ms\n", before.total_ms, before.tail_ms);
+    printf("stealing, equal weights: total %6.1f ms, tail %6.1f ms\n", equal.total_ms, equal.tail_ms);
+    printf("stealing, measured:      total %6.1f ms, tail %6.1f ms\n", weighted.total_ms, weighted.tail_ms);
+}
+
+int main() {
+    check_exactly_once(ChunkOrder(), "linear order");
+    check_exactly_once(ChunkOrder(3001, 0x5eed), "random order");
+    bench_tail_latency();
+    return test_result("range_scheduler_test");
+}
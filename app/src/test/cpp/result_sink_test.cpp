@@ -0,0 +1,144 @@
+// سجل النتائج عبر إعادة الفتح: كل مفتاح يُقرأ كما كُتب، ومنه هدف المفتاح العام الكامل (130 خانة)
+// دون قطع. ثم ملف تالف: بايتات مقلوبة في خانة، ونسخة مكررة من خانة سليمة، وخانة أخيرة قطعها موت العملية
+// بعد الترويسة. الخانات السليمة تُقرأ مرة واحدة لكل منها والتالفة تُتخطى، والملف يُعاد كتابته نظيفًا
+
+#include "result_sink.h"
+#include "test_support.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+// تخطيط الملف كما في result_sink.cpp: خانات 512 بايت، ترويسة 16 بايت ثم النص
+static const size_t SLOT_SIZE = 512, SLOT_HEADER = 16;
+
+static FoundKey found_key(uint64_t scalar, const std::string& address, const char* format) {
+    FoundKey key;
+    memset(&key, 0, sizeof(key));
+    key.scalar = u256_from_u64(scalar);
+    snprintf(key.address, sizeof(key.address), "%s", address.c_str());
+    snprintf(key.format, sizeof(key.format), "%s", format);
+    key.range_first = u256_from_u64(1);
+    key.range_last = U256{{~0ull, ~0ull, ~0ull, 0x7fffffffffffffffull}};
+    key.timestamp = 1700000000 + (int64_t)scalar;
+    return key;
+}
+
+static bool same(const FoundKey& a, const FoundKey& b) {
+    return u256_cmp(a.scalar, b.scalar) == 0 && strcmp(a.address, b.address) == 0 &&
+           strcmp(a.format, b.format) == 0 && u256_cmp(a.range_first, b.range_first) == 0 &&
+           u256_cmp(a.range_last, b.range_last) == 0 && a.timestamp == b.timestamp;
+}
+
+static void check_long_targets(const std::string& dir) {
+    const std::string gx = "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798";
+    const std::string gy = "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
+    const FoundKey keys[] = {
+        found_key(1, "04" + gx + gy, "known"),
+        found_key(1, "02" + gx, "known"),
+        found_key(1, "bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqzk5jj0", "taproot"),
+    };
+    in_child([&] {
+        std::shared_ptr<ResultSink> sink = ResultSink::open(dir);
+        CHECK(sink != nullptr, "open %s", dir.c_str());
+        for (const FoundKey& key : keys) CHECK(sink->push(key), "push");
+        sink->flush();
+    });
+    std::shared_ptr<ResultSink> sink = ResultSink::open(dir);
+    std::vector<FoundKey> records = sink ? sink->records() : std::vector<FoundKey>();
+    CHECK(records.size() == 3, "%zu records replayed, expected 3", records.size());
+    for (size_t i = 0; i < records.size() && i < 3; ++i) {
+        CHECK(same(records[i], keys[i]), "record %zu: %s", i, found_key_to_string(records[i]).c_str());
+    }
+}
+
+static std::vector<unsigned char> read_file(const std::string& path) {
+    std::vector<unsigned char> data;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f == nullptr) return data;
+    unsigned char buf[4096];
+    for (size_t n; (n = fread(buf, 1, sizeof(buf), f)) > 0;) data.insert(data.end(), buf, buf + n);
+    fclose(f);
+    return data;
+}
+
+static void write_at(const std::string& path, const unsigned char* p, size_t size, off_t offset) {
+    int fd = open(path.c_str(), O_WRONLY);
+    CHECK(fd >= 0 && pwrite(fd, p, size, offset) == (ssize_t)size, "write %s", path.c_str());
+    close(fd);
+}
+
+// عدد الخانات المكتوبة: حتى أول خانة ترويستها أصفار (ما بعدها محجوز بـ fallocate)
+static size_t used_slots(const std::string& path) {
+    const std::vector<unsigned char> data = read_file(path);
+    size_t slots = 0;
+    while ((slots + 1) * SLOT_SIZE <= data.size() && memcmp(&data[slots * SLOT_SIZE], "\0\0\0\0", 4) != 0) {
+        ++slots;
+    }
+    return slots;
+}
+
+static void check_damaged_slots(const std::string& dir) {
+    const std::string path = dir + "/found_keys.log";
+    std::vector<FoundKey> keys;
+    for (uint64_t k = 1; k <= 6; ++k) {
+        keys.push_back(
+            found_key(k * 0x1000003, "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH", k % 2 ? "compressed" : "taproot"));
+    }
+    in_child([&] {
+        std::shared_ptr<ResultSink> sink = ResultSink::open(dir);
+        CHECK(sink != nullptr, "open %s", dir.c_str());
+        for (const FoundKey& key : keys) CHECK(sink->push(key), "push");
+        sink->flush();
+    });
+    CHECK(used_slots(path) == keys.size(), "%zu slots written, expected %zu", used_slots(path), keys.size());
+
+    // الخانة 2: بايت مقلوب في النص و CRC لا يطابق. الخانة 1 تُنسخ بعد الأخيرة (مكررة)،
+    // وبعدها ترويسة سليمة بلا نص كخانة قطعها موت العملية أثناء الكتابة
+    std::vector<unsigned char> data = read_file(path);
+    unsigned char flipped = data[2 * SLOT_SIZE + SLOT_HEADER + 10] ^ 0x20;
+    write_at(path, &flipped, 1, 2 * SLOT_SIZE + SLOT_HEADER + 10);
+    write_at(path, &data[1 * SLOT_SIZE], SLOT_SIZE, 6 * SLOT_SIZE);
+    std::vector<unsigned char> torn(SLOT_SIZE, 0);
+    memcpy(torn.data(), &data[3 * SLOT_SIZE], SLOT_HEADER);
+    write_at(path, torn.data(), SLOT_SIZE, 7 * SLOT_SIZE);
+
+    std::vector<FoundKey> good = keys;
+    good.erase(good.begin() + 2);
+    in_child([&] {
+        std::shared_ptr<ResultSink> sink = ResultSink::open(dir);
+        std::vector<FoundKey> records = sink ? sink->records() : std::vector<FoundKey>();
+        CHECK(records.size() == good.size(), "%zu records replayed from the damaged log, expected %zu",
+              records.size(), good.size());
+        for (size_t i = 0; i < records.size() && i < good.size(); ++i) {
+            CHECK(same(records[i], good[i]), "record %zu: %s", i, found_key_to_string(records[i]).c_str());
+        }
+    });
+    CHECK(used_slots(path) == good.size(), "damaged log rewritten with %zu slots, expected %zu", used_slots(path),
+          good.size());
+
+    // الملف المعاد كتابته يُقرأ كما هو، والمفتاح الذي ضاعت خانته يُحفظ من جديد في آخره
+    std::shared_ptr<ResultSink> sink = ResultSink::open(dir);
+    std::vector<FoundKey> records = sink ? sink->records() : std::vector<FoundKey>();
+    CHECK(records.size() == good.size(), "%zu records after the rewrite, expected %zu", records.size(), good.size());
+    if (sink) {
+        CHECK(sink->push(keys[2]), "push");
+        sink->flush();
+        records = sink->records();
+        CHECK(records.size() == keys.size() && same(records.back(), keys[2]), "lost key not stored again");
+    }
+    CHECK(used_slots(path) == keys.size(), "%zu slots after storing the lost key", used_slots(path));
+}
+
+int main() {
+    const std::string root = make_temp_dir("result_sink_test");
+    check_long_targets(root);
+    const std::string damaged = root + "/damaged";
+    mkdir(damaged.c_str(), 0700);
+    check_damaged_slots(damaged);
+    remove_tree(root);
+    return test_result("result_sink_test");
+}
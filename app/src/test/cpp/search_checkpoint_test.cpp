@@ -0,0 +1,205 @@
+// الاستئناف بعد قتل العملية: بحث في عملية فرعية يُقتل بـ SIGKILL وسط النطاق (مرتين، فتُنقل مؤشرات
+// التشغيل الأول عبر الثاني)، ثم لكل مفتاح مختبر يُستأنف بحث من نسخة نقطة الاستئناف نفسها بهدف هذا
+// المفتاح: يجب أن يجده إن لم تغطه نقطة الاستئناف، وألا يجده إن غطته (بلا فجوات ولا تكرار).
+// ثم يكمل استئناف أخير النطاق: المفاتيح المستأنفة مع المفحوصة تساوي النطاق، ويُحذف الملف.
+// وملف نقطة استئناف لبحث آخر في المجلد يُحذف عند فتح هذا البحث
+
+#include "oracle.h"
+#include "search_support.h"
+#include "test_support.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <random>
+#include <string>
+#include <thread>
+
+static const uint64_t FIRST = 1, LAST = 2000000, CHUNK_KEYS = 16384;
+static const std::chrono::milliseconds TIMEOUT(60000);
+
+static CheckpointIdentity identity(const RangeScheduler& scheduler) {
+    CheckpointIdentity id;
+    memset(&id, 0, sizeof(id));
+    id.start = u256_from_u64(FIRST);
+    id.end = u256_from_u64(LAST);
+    id.chunk_keys = u256_from_u64(CHUNK_KEYS);
+    id.chunk_count = scheduler.chunk_count();
+    // بصمة ثابتة: كل تشغيل بهدف مختلف يستأنف نفس الملف
+    memset(id.targets, 0x5A, sizeof(id.targets));
+    return id;
+}
+
+static RangeScheduler make_scheduler(size_t workers) {
+    return RangeScheduler(u256_from_u64(FIRST), u256_from_u64(LAST), u256_from_u64(CHUNK_KEYS),
+                          std::vector<double>(workers, 1.0), 1);
+}
+
+// من OpenSSL لا من المحرك، فلا يختبر المحرك نفسه بنفسه
+static void hash160_of(uint64_t key, unsigned char out[20]) {
+    oracle_key_hash(u256_from_u64(key), true, out);
+}
+
+struct RunResult {
+    uint64_t resumed;
+    uint64_t checked;
+    bool found;
+};
+
+// بحث في dir عن مفتاح target (0: هدف لا يُطابق). kill_at > 0: تقتل العملية نفسها بعد فحص هذا العدد
+static RunResult run_search(const std::string& dir, uint64_t target, uint64_t kill_at) {
+    SearchSession session(4, nullptr, nullptr);
+    unsigned char h[20];
+    memset(h, 0xAB, sizeof(h));
+    if (target != 0) hash160_of(target, h);
+    auto listener = std::make_shared<RecordingListener>();
+    SearchJob job = search_job(session, FIRST, LAST, h, PubkeyMode::Compressed, listener);
+    job.scheduler = std::make_shared<RangeScheduler>(u256_from_u64(FIRST), u256_from_u64(LAST),
+                                                     u256_from_u64(CHUNK_KEYS),
+                                                     std::vector<double>(session.workers(), 1.0), 1);
+    job.checkpoint = SearchCheckpoint::open(dir, identity(*job.scheduler));
+    RunResult result = {job.checkpoint ? job.checkpoint->resumed_keys().d[0] : 0, 0, false};
+    session.start(job, TIMEOUT);
+    SearchStatus status;
+    if (kill_at > 0) {
+        for (;;) {
+            if (session.status().read(status) && status.keys_checked >= kill_at) kill(getpid(), SIGKILL);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    listener->wait(TIMEOUT);
+    session.stop(TIMEOUT);
+    session.status().read(status);
+    result.checked = status.keys_checked;
+    result.found = !listener->keys.empty() && listener->keys[0].d[0] == target;
+    return result;
+}
+
+// run_search في عملية فرعية: العامل يملك خيوطًا، والعملية الأم تبقى بخيط واحد لكل fork تالٍ
+static int run_child(const std::string& dir, uint64_t target, uint64_t kill_at, RunResult* out) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        RunResult r = run_search(dir, target, kill_at);
+        ssize_t written = write(fds[1], &r, sizeof(r));
+        _exit(written == (ssize_t)sizeof(r) ? 0 : 2);
+    }
+    close(fds[1]);
+    RunResult r = {};
+    bool got = read(fds[0], &r, sizeof(r)) == (ssize_t)sizeof(r);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (got && out != nullptr) *out = r;
+    return status;
+}
+
+static std::string only_checkpoint(const std::string& dir, size_t* count) {
+    std::string name;
+    *count = 0;
+    DIR* d = opendir(dir.c_str());
+    while (struct dirent* entry = readdir(d)) {
+        if (strncmp(entry->d_name, "checkpoint_", 11) == 0) {
+            name = entry->d_name;
+            ++*count;
+        }
+    }
+    closedir(d);
+    return name;
+}
+
+static void copy_dir(const std::string& from, const std::string& to) {
+    mkdir(to.c_str(), 0700);
+    size_t count;
+    std::string name = only_checkpoint(from, &count);
+    int in = open((from + "/" + name).c_str(), O_RDONLY);
+    int out = open((to + "/" + name).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    char buf[65536];
+    ssize_t n;
+    while ((n = read(in, buf, sizeof(buf))) > 0) CHECK(write(out, buf, (size_t)n) == n, "copy");
+    close(in);
+    close(out);
+}
+
+int main() {
+    const std::string root = make_temp_dir("checkpoint_test");
+    const std::string dir = root + "/run";
+    mkdir(dir.c_str(), 0700);
+    const uint64_t range = LAST - FIRST + 1;
+
+    // قتلان في منتصف النطاق
+    for (uint64_t kill_at : {range * 3 / 10, range * 3 / 10}) {
+        int status = run_child(dir, 0, kill_at, nullptr);
+        CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL, "child was not killed (status %d)", status);
+    }
+
+    // ما تغطيه نقطة الاستئناف، من نسخة (الفتح ينقل المؤشرات ويعيد كتابتها)
+    const std::string snapshot = root + "/snapshot";
+    copy_dir(dir, snapshot);
+    RangeScheduler scheduler = make_scheduler(1);
+    auto checkpoint = SearchCheckpoint::open(snapshot, identity(scheduler));
+    CHECK(checkpoint != nullptr, "cannot open checkpoint copy");
+    if (checkpoint == nullptr) return test_result("search_checkpoint_test");
+    auto covered = [&](uint64_t key) {
+        uint64_t index = scheduler.chunk_index(u256_from_u64(key));
+        return checkpoint->chunk_done(index) ||
+               key < checkpoint->resume_point(index, scheduler.chunk(index).first).d[0];
+    };
+    // حدود التغطية (مؤشرات القطع الجزئية وحدود القطع المكتملة) ومفاتيح عشوائية
+    std::vector<uint64_t> probes;
+    size_t done = 0, partial = 0;
+    for (uint64_t c = 0; c < scheduler.chunk_count(); ++c) {
+        const uint64_t first = scheduler.chunk(c).first.d[0];
+        const uint64_t resume = checkpoint->resume_point(c, scheduler.chunk(c).first).d[0];
+        done += checkpoint->chunk_done(c) ? 1 : 0;
+        if (resume != first && partial++ < 3) {
+            probes.push_back(resume - 1);
+            probes.push_back(resume);
+        }
+        if (c > 0 && checkpoint->chunk_done(c) != checkpoint->chunk_done(c - 1) && probes.size() < 10) {
+            probes.push_back(first - 1);
+            probes.push_back(first);
+        }
+    }
+    std::mt19937_64 rng(18);
+    for (int i = 0; i < 4; ++i) probes.push_back(FIRST + rng() % range);
+    printf("after two kills: %zu of %llu chunks done, %zu partial, %llu keys resumed\n", done,
+           (unsigned long long)scheduler.chunk_count(), partial, (unsigned long long)checkpoint->resumed_keys().d[0]);
+    CHECK(done > 0 && done < scheduler.chunk_count(), "kills were not mid-range");
+
+    size_t agreeing = 0;
+    for (uint64_t key : probes) {
+        const std::string probe_dir = root + "/probe";
+        copy_dir(dir, probe_dir);
+        RunResult r = {};
+        run_child(probe_dir, key, 0, &r);
+        const bool is_covered = covered(key);
+        CHECK(r.found != is_covered, "key %llu covered=%d found=%d", (unsigned long long)key, is_covered, r.found);
+        agreeing += r.found != is_covered ? 1 : 0;
+        remove_tree(probe_dir);
+    }
+    printf("%zu of %zu probe keys: found exactly when not covered by the checkpoint\n", agreeing, probes.size());
+    checkpoint.reset();
+
+    // بحث آخر ترك نقطة استئنافه: تُحذف حين يبدأ هذا
+    int stale = open((dir + "/checkpoint_0000000000000001.bin").c_str(), O_WRONLY | O_CREAT, 0600);
+    close(stale);
+    RunResult last = {};
+    run_child(dir, 0, 0, &last);
+    printf("final resume: %llu resumed + %llu checked = %llu (range %llu)\n", (unsigned long long)last.resumed,
+           (unsigned long long)last.checked, (unsigned long long)(last.resumed + last.checked),
+           (unsigned long long)range);
+    CHECK(last.resumed + last.checked == range, "resumed + checked != range");
+    size_t left;
+    only_checkpoint(dir, &left);
+    CHECK(left == 0, "%zu checkpoint files left after the range completed", left);
+
+    remove_tree(root);
+    return test_result("search_checkpoint_test");
+}
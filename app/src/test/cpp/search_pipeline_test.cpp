@@ -0,0 +1,265 @@
+// أنواع الأهداف في كل صيغة بحث، بالنواة المخصصة وبالمسار العام run_stages:
+//   - P2WPKH (bc1q) و P2SH-P2WPKH (3...) لا يلتزمان إلا بالمفتاح المضغوط، فيُوجدان حتى في البحث
+//     غير المضغوط، ولا يطابق برنامجَ الشاهد hash160 لمفتاح غير مضغوط
+//   - P2PKH يُطابق الصيغة المطلوبة فقط
+//   - المفتاح العام المعروف (02 و 03 و 04 بعد فكه من الست عشري) يُوجد في أي صيغة، وزوجية y الخاطئة لا تطابق
+//   - النواة المخصصة و run_stages تعطيان نفس المطابقات لنفس النطاق بكل أنواع الأهداف معًا
+// ثم مفاتيح/ث لأهداف المفاتيح العامة مقابل hash160 على النطاق نفسه، وللنواة المخصصة مقابل run_stages،
+// ولصيغة Both مقابل صيغة واحدة
+
+#include "hash_mb.h"
+#include "oracle.h"
+#include "target_decode.h"
+#include "pipeline_support.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+
+static const uint64_t FIRST = 1, LAST = 4096;
+static const size_t GROUP = 1024;
+
+static void redeem_script_hash(uint64_t key, unsigned char out[20]) {
+    unsigned char script[22] = {0x00, 0x14};
+    oracle_key_hash(u256_from_u64(key), true, script + 2);
+    oracle_hash160(script, sizeof(script), out);
+}
+
+static const char* mode_name(PubkeyMode mode) {
+    return mode == PubkeyMode::Compressed ? "compressed" : mode == PubkeyMode::Uncompressed ? "uncompressed" : "both";
+}
+
+static void check_compressed_only_kinds(const GeneratorTable& table) {
+    // الأهداف: 0 bc1q للمفتاح 1000، 1 هو 3... للمفتاح 2500، 2 bc1q ببرنامج hash160 غير المضغوط
+    // للمفتاح 3000 (لا يوجد)، 3 هو 1... غير المضغوط للمفتاح 3500، 4 هو 1... المضغوط للمفتاح 700
+    unsigned char digest[20];
+    std::vector<TargetSpec> specs;
+    oracle_key_hash(u256_from_u64(1000), true, digest);
+    specs.push_back(target_spec(TargetKind::WitnessKeyHash, digest));
+    redeem_script_hash(2500, digest);
+    specs.push_back(target_spec(TargetKind::ScriptHash, digest));
+    oracle_key_hash(u256_from_u64(3000), false, digest);
+    specs.push_back(target_spec(TargetKind::WitnessKeyHash, digest));
+    oracle_key_hash(u256_from_u64(3500), false, digest);
+    specs.push_back(target_spec(TargetKind::KeyHash, digest));
+    oracle_key_hash(u256_from_u64(700), true, digest);
+    specs.push_back(target_spec(TargetKind::KeyHash, digest));
+
+    for (PubkeyMode mode : {PubkeyMode::Compressed, PubkeyMode::Uncompressed, PubkeyMode::Both}) {
+        std::vector<RangeHit> want = {{1000, "compressed", 0}, {2500, "compressed", 1}};
+        if (mode != PubkeyMode::Compressed) want.push_back({3500, "uncompressed", 3});
+        if (mode != PubkeyMode::Uncompressed) want.push_back({700, "compressed", 4});
+        std::sort(want.begin(), want.end());
+
+        // المجموعة كلها، ثم كل هدف وحده (نواة الهدف الواحد)
+        for (size_t only = 0; only <= specs.size(); ++only) {
+            const bool all = only == specs.size();
+            auto targets = std::make_shared<const TargetSet>(all ? specs.data() : &specs[only], all ? specs.size() : 1);
+            std::vector<RangeHit> expected;
+            for (RangeHit hit : want) {
+                if (all) expected.push_back(hit);
+                else if (hit.target == only) expected.push_back(RangeHit{hit.key, hit.format, 0});
+            }
+            for (bool generic : {false, true}) {
+                SearchPipeline pipeline(table, GROUP, mode, targets, simd_best_backend(),
+                                        generic ? generic_stages() : default_pipeline_stages());
+                std::vector<RangeHit> got = pipeline_hits(pipeline, FIRST, LAST);
+                std::sort(got.begin(), got.end());
+                CHECK(got == expected, "%s mode, %s, %s: %zu hits, expected %zu", mode_name(mode),
+                      generic ? "run_stages" : "kernel", all ? "all targets" : "single target", got.size(),
+                      expected.size());
+            }
+        }
+    }
+}
+
+static std::string pubkey_hex(uint64_t key, bool compressed) {
+    unsigned char pubkey[65];
+    oracle_pubkey(u256_from_u64(key), compressed, pubkey);
+    std::string out;
+    char byte[3];
+    for (size_t i = 0; i < (compressed ? 33u : 65u); ++i) {
+        snprintf(byte, sizeof(byte), "%02x", pubkey[i]);
+        out += byte;
+    }
+    return out;
+}
+
+static void check_public_keys(const GeneratorTable& table) {
+    // أول مفتاح بعد 1500 بـ y زوجي وأول مفتاح بـ y فردي، ومفتاح بصيغة 04، ومفتاح بزوجية معكوسة
+    uint64_t even = 1500, odd = 1500;
+    while (pubkey_hex(even, true)[1] != '2') ++even;
+    while (pubkey_hex(odd, true)[1] != '3') ++odd;
+    const uint64_t full = 3333, flipped = 2222;
+    std::string wrong = pubkey_hex(flipped, true);
+    wrong[1] = wrong[1] == '2' ? '3' : '2';
+    const std::string inputs[] = {pubkey_hex(even, true), pubkey_hex(odd, true), pubkey_hex(full, false), wrong};
+    std::vector<TargetSpec> specs;
+    for (const std::string& hex : inputs) {
+        TargetSpec spec;
+        CHECK(decode_target(hex, spec) && spec.kind == TargetKind::PublicKey, "decode %s", hex.c_str());
+        specs.push_back(spec);
+    }
+    std::vector<RangeHit> want = {{even, "known", 0}, {odd, "known", 1}, {full, "known", 2}};
+    std::sort(want.begin(), want.end());
+
+    for (PubkeyMode mode : {PubkeyMode::Compressed, PubkeyMode::Uncompressed, PubkeyMode::Both}) {
+        for (size_t only = 0; only <= specs.size(); ++only) {
+            const bool all = only == specs.size();
+            auto targets = std::make_shared<const TargetSet>(all ? specs.data() : &specs[only], all ? specs.size() : 1);
+            std::vector<RangeHit> expected;
+            for (RangeHit hit : want) {
+                if (all) expected.push_back(hit);
+                else if (hit.target == only) expected.push_back(RangeHit{hit.key, hit.format, 0});
+            }
+            for (bool generic : {false, true}) {
+                SearchPipeline pipeline(table, GROUP, mode, targets, simd_best_backend(),
+                                        generic ? generic_stages() : default_pipeline_stages());
+                std::vector<RangeHit> got = pipeline_hits(pipeline, FIRST, LAST);
+                std::sort(got.begin(), got.end());
+                CHECK(got == expected, "public keys, %s mode, %s, target %zu: %zu hits, expected %zu", mode_name(mode),
+                      generic ? "run_stages" : "kernel", only, got.size(), expected.size());
+            }
+        }
+    }
+}
+
+static void bench_public_keys(const GeneratorTable& table) {
+    const uint64_t KEYS = 1 << 18;
+    std::mt19937_64 rng(25);
+    for (size_t count : {1, 16}) {
+        std::vector<TargetSpec> key_hashes, public_keys;
+        for (size_t i = 0; i < count; ++i) {
+            // مفاتيح خارج النطاق المقاس، فلا مطابقة
+            const uint64_t key = 1000000 + rng() % 1000000;
+            unsigned char digest[20];
+            oracle_key_hash(u256_from_u64(key), true, digest);
+            key_hashes.push_back(target_spec(TargetKind::KeyHash, digest));
+            TargetSpec spec;
+            decode_target(pubkey_hex(key, true), spec);
+            public_keys.push_back(spec);
+        }
+        const double hash160 = keys_per_second(table, PubkeyMode::Compressed, key_hashes, KEYS);
+        const double pubkey = keys_per_second(table, PubkeyMode::Compressed, public_keys, KEYS);
+        printf("%zu target(s), %llu keys: KeyHash %.0f keys/s, PublicKey %.0f keys/s (x%.2f)\n", count,
+               (unsigned long long)KEYS, hash160, pubkey, pubkey / hash160);
+        CHECK(pubkey > hash160, "public-key targets slower than hash160 targets");
+    }
+}
+
+static void check_kernel_matches_stages(const GeneratorTable& table, std::mt19937_64& rng) {
+    // كل نوع عند مفاتيح عشوائية في 6 دفعات تبدأ من مفتاح بعرض 256 بت، ومعها أهداف لا تطابق
+    const uint64_t COUNT = 6 * GROUP - 100;
+    const U256 first = {{rng(), rng(), rng(), rng() >> 2}};
+    std::vector<TargetSpec> specs;
+    for (int i = 0; i < 4; ++i) {
+        U256 k;
+        u256_add_u64(k, first, rng() % COUNT);
+        unsigned char digest[33], script[22] = {0x00, 0x14};
+        oracle_key_hash(k, true, digest);
+        specs.push_back(target_spec(TargetKind::KeyHash, digest));
+        u256_add_u64(k, k, 1);
+        oracle_key_hash(k, false, digest);
+        specs.push_back(target_spec(TargetKind::KeyHash, digest));
+        u256_add_u64(k, k, 1);
+        oracle_key_hash(k, true, digest);
+        specs.push_back(target_spec(TargetKind::WitnessKeyHash, digest));
+        u256_add_u64(k, k, 1);
+        oracle_key_hash(k, true, script + 2);
+        oracle_hash160(script, sizeof(script), digest);
+        specs.push_back(target_spec(TargetKind::ScriptHash, digest));
+        u256_add_u64(k, k, 1);
+        oracle_taproot_output(k, digest);
+        specs.push_back(target_spec(TargetKind::TaprootOutput, digest));
+        u256_add_u64(k, k, 1);
+        unsigned char pubkey[33];
+        oracle_pubkey(k, true, pubkey);
+        memcpy(digest, pubkey + 1, 32);
+        digest[32] = pubkey[0] == 0x03;
+        specs.push_back(target_spec(TargetKind::PublicKey, digest));
+    }
+    for (TargetKind kind : {TargetKind::KeyHash, TargetKind::WitnessKeyHash, TargetKind::ScriptHash,
+                            TargetKind::TaprootOutput, TargetKind::PublicKey}) {
+        unsigned char digest[33];
+        for (unsigned char& c : digest) c = (unsigned char)rng();
+        specs.push_back(target_spec(kind, digest));
+    }
+    auto targets = std::make_shared<const TargetSet>(specs.data(), specs.size());
+
+    for (PubkeyMode mode : {PubkeyMode::Compressed, PubkeyMode::Uncompressed, PubkeyMode::Both}) {
+        SearchPipeline kernel(table, GROUP, mode, targets, simd_best_backend());
+        SearchPipeline stages(table, GROUP, mode, targets, simd_best_backend(), generic_stages());
+        std::vector<RangeHit> a = pipeline_hits(kernel, first, COUNT), b = pipeline_hits(stages, first, COUNT);
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        // المضغوط: 4 لكل مجموعة عدا غير المضغوط، وغير المضغوط: 4 لكل مجموعة عدا P2PKH المضغوط
+        const size_t expected = mode == PubkeyMode::Both ? 24 : 20;
+        CHECK(a == b, "%s mode: kernel %zu hits, run_stages %zu hits", mode_name(mode), a.size(), b.size());
+        CHECK(a.size() == expected, "%s mode: %zu hits, expected %zu", mode_name(mode), a.size(), expected);
+    }
+}
+
+static void bench_kernel_vs_stages(const GeneratorTable& table, std::mt19937_64& rng) {
+    const uint64_t KEYS = 1 << 17;
+    struct Case {
+        const char* name;
+        PubkeyMode mode;
+        std::vector<TargetKind> kinds;
+    };
+    const Case cases[] = {
+        {"1 P2PKH, compressed", PubkeyMode::Compressed, {TargetKind::KeyHash}},
+        {"16 P2PKH, compressed", PubkeyMode::Compressed, std::vector<TargetKind>(16, TargetKind::KeyHash)},
+        {"1 P2PKH, both", PubkeyMode::Both, {TargetKind::KeyHash}},
+        {"P2PKH + bc1q + 3..., both", PubkeyMode::Both,
+         {TargetKind::KeyHash, TargetKind::WitnessKeyHash, TargetKind::ScriptHash}},
+        {"1 public key", PubkeyMode::Compressed, {TargetKind::PublicKey}},
+    };
+    // تسخين قبل أول قياس: تردد المعالج وذاكرة الجدول
+    keys_per_second(table, PubkeyMode::Compressed, {}, KEYS);
+    for (const Case& c : cases) {
+        std::vector<TargetSpec> specs;
+        for (TargetKind kind : c.kinds) {
+            unsigned char digest[33];
+            for (unsigned char& b : digest) b = (unsigned char)rng();
+            specs.push_back(target_spec(kind, digest));
+        }
+        // المساران بالتناوب وأفضل قيمة لكل منهما، حتى لا يقع ضجيج الجهاز على أحدهما
+        double generic = 0, kernel = 0;
+        for (int round = 0; round < 3; ++round) {
+            generic = std::max(generic, keys_per_second(table, c.mode, specs, KEYS, generic_stages()));
+            kernel = std::max(kernel, keys_per_second(table, c.mode, specs, KEYS));
+        }
+        printf("%-28s run_stages %8.0f keys/s, kernel %8.0f keys/s (x%.2f)\n", c.name, generic, kernel,
+               kernel / generic);
+    }
+}
+
+// Both يجزئ كل مفتاح بالصيغتين: تكلفته مقابل صيغة واحدة لنفس الهدف
+static void bench_pubkey_modes(const GeneratorTable& table, std::mt19937_64& rng) {
+    const uint64_t KEYS = 1 << 17;
+    unsigned char digest[20];
+    for (unsigned char& b : digest) b = (unsigned char)rng();
+    const std::vector<TargetSpec> specs = {target_spec(TargetKind::KeyHash, digest)};
+    double rates[3] = {0, 0, 0};
+    const PubkeyMode modes[3] = {PubkeyMode::Compressed, PubkeyMode::Uncompressed, PubkeyMode::Both};
+    for (int round = 0; round < 3; ++round) {
+        for (int m = 0; m < 3; ++m) rates[m] = std::max(rates[m], keys_per_second(table, modes[m], specs, KEYS));
+    }
+    printf("1 P2PKH target: compressed %.0f keys/s, uncompressed %.0f keys/s, both %.0f keys/s "
+           "(x%.2f of compressed)\n",
+           rates[0], rates[1], rates[2], rates[2] / rates[0]);
+}
+
+int main() {
+    std::shared_ptr<const GeneratorTable> table = GeneratorTable::open_or_build("");
+    check_compressed_only_kinds(*table);
+    check_public_keys(*table);
+    std::mt19937_64 rng(23);
+    check_kernel_matches_stages(*table, rng);
+    bench_public_keys(*table);
+    bench_kernel_vs_stages(*table, rng);
+    bench_pubkey_modes(*table, rng);
+    return test_result("search_pipeline_test");
+}
@@ -0,0 +1,176 @@
+// زمن SearchSession::stop() من لحظة الطلب حتى خروج كل العمال، أثناء البحث وأثناء الإيقاف المؤقت.
+// العمال يفحصون التحكم بين الدفعات، فالحد دفعة واحدة لكل عامل (~1 ms لـ 1024 مفتاحًا على نواة
+// كبيرة). الاختبار يقبل هامشًا واسعًا لأجهزة CI المشتركة، ويطبع الوسيط و p95 والأقصى.
+// ثم انتهاء البحث بنفسه: حين يُوجد كل هدف مختلف (ولو تكرر في القائمة، أو طابق مفتاح واحد هدفين)،
+// لا قبل ذلك، ومنه Both بهدف مضغوط وآخر غير مضغوط في نفس النطاق.
+// وأخيرًا زمن بدء البحث: من start() حتى إبلاغ هدف في أول مفتاح، بمجمع العمال الدائم مقابل جلسة جديدة
+// تنشئ خيوطها لكل بحث كما كان قبل المجمع
+
+#include "oracle.h"
+#include "search_support.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+
+static const std::chrono::milliseconds STOP_TIMEOUT(1000);
+static const double P95_BOUND_MS = 50;
+static const double MAX_BOUND_MS = 250;
+
+static double ms_since(std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t).count();
+}
+
+static void report(const char* name, std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    const double p95 = samples[samples.size() * 95 / 100], max = samples.back();
+    printf("%-30s median %.2f ms, p95 %.2f ms, max %.2f ms\n", name, samples[samples.size() / 2], p95, max);
+    CHECK(p95 < P95_BOUND_MS, "%s p95 %.2f ms", name, p95);
+    CHECK(max < MAX_BOUND_MS, "%s max %.2f ms", name, max);
+}
+
+static TargetSpec key_target(uint64_t key, TargetKind kind) {
+    TargetSpec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.kind = kind;
+    oracle_key_hash(u256_from_u64(key), true, spec.digest);
+    return spec;
+}
+
+static void check_stops_when_all_found(SearchSession& session) {
+    const uint64_t HUGE_RANGE = 1ull << 40;
+    const TargetSpec a = key_target(20000, TargetKind::KeyHash), b = key_target(250000, TargetKind::KeyHash);
+    const TargetSpec a_witness = key_target(20000, TargetKind::WitnessKeyHash);
+    TargetSpec absent = a;
+    absent.digest[0] ^= 0xff;
+    struct Case {
+        const char* name;
+        uint64_t last;
+        std::vector<TargetSpec> targets;
+        size_t keys;
+        bool finishes;
+    };
+    const Case cases[] = {
+        {"two targets in range", 300000, {a, b}, 2, true},
+        {"duplicate target", HUGE_RANGE, {a, a, a}, 1, true},
+        {"one key, two targets", HUGE_RANGE, {a, a_witness}, 2, true},
+        {"one target never found", HUGE_RANGE, {a, absent}, 1, false},
+    };
+    for (const Case& c : cases) {
+        auto listener = std::make_shared<RecordingListener>();
+        CHECK(session.start(search_job(session, 1, c.last, c.targets, PubkeyMode::Compressed, listener), STOP_TIMEOUT),
+              "start");
+        // البحث الذي لا ينتهي بنفسه يمشي 2^40 مفتاحًا، أي ساعات
+        const bool finished = listener->wait(std::chrono::milliseconds(c.finishes ? 30000 : 1500));
+        CHECK(finished == c.finishes, "%s: finished=%d", c.name, finished);
+        CHECK(session.stop(STOP_TIMEOUT), "%s: stop", c.name);
+        CHECK(listener->wait(STOP_TIMEOUT), "%s: on_finished", c.name);
+        std::lock_guard<std::mutex> lock(listener->mutex);
+        CHECK(listener->keys.size() == c.keys, "%s: %zu keys reported, expected %zu", c.name, listener->keys.size(),
+              c.keys);
+    }
+}
+
+// Both: مفتاح بهدف مضغوط وآخر بهدف غير مضغوط في نفس النطاق، كل منهما بصيغته، ثم ينتهي البحث
+static void check_both_formats(SearchSession& session) {
+    std::vector<TargetSpec> targets(2);
+    memset(targets.data(), 0, targets.size() * sizeof(TargetSpec));
+    targets[0].kind = targets[1].kind = TargetKind::KeyHash;
+    oracle_key_hash(u256_from_u64(20000), true, targets[0].digest);
+    oracle_key_hash(u256_from_u64(250000), false, targets[1].digest);
+
+    auto listener = std::make_shared<RecordingListener>();
+    CHECK(session.start(search_job(session, 1, 300000, targets, PubkeyMode::Both, listener), STOP_TIMEOUT), "start");
+    CHECK(listener->wait(std::chrono::milliseconds(30000)), "both formats: search did not finish");
+    CHECK(session.stop(STOP_TIMEOUT), "both formats: stop");
+    std::lock_guard<std::mutex> lock(listener->mutex);
+    CHECK(listener->keys.size() == 2, "both formats: %zu keys reported, expected 2", listener->keys.size());
+    for (size_t i = 0; i < listener->keys.size(); ++i) {
+        const bool compressed = u256_cmp(listener->keys[i], u256_from_u64(20000)) == 0;
+        const bool uncompressed = u256_cmp(listener->keys[i], u256_from_u64(250000)) == 0;
+        CHECK((compressed && listener->formats[i] == "compressed") ||
+                  (uncompressed && listener->formats[i] == "uncompressed"),
+              "both formats: key %llu found as %s", (unsigned long long)listener->keys[i].d[0],
+              listener->formats[i].c_str());
+    }
+}
+
+struct FirstKeyListener : RecordingListener {
+    std::chrono::steady_clock::time_point found_at;
+
+    void on_key_found(const U256& key, const char* format, size_t target) override {
+        found_at = std::chrono::steady_clock::now();
+        RecordingListener::on_key_found(key, format, target);
+    }
+};
+
+// الهدف هو المفتاح 1، فالزمن هو البدء وأول دفعة لكل عامل. fresh: جلسة جديدة لكل بحث
+static double start_to_first_key_ms(SearchSession& pool, bool fresh) {
+    TargetSpec spec = key_target(1, TargetKind::KeyHash);
+    auto listener = std::make_shared<FirstKeyListener>();
+    const auto t0 = std::chrono::steady_clock::now();
+    std::unique_ptr<SearchSession> own;
+    if (fresh) own.reset(new SearchSession(pool.workers(), nullptr, nullptr));
+    SearchSession& session = fresh ? *own : pool;
+    CHECK(session.start(search_job(session, 1, 1ull << 40, {spec}, PubkeyMode::Compressed, listener), STOP_TIMEOUT),
+          "start");
+    CHECK(listener->wait(std::chrono::milliseconds(5000)), "first key not found");
+    CHECK(session.stop(STOP_TIMEOUT), "stop after the first key");
+    std::lock_guard<std::mutex> lock(listener->mutex);
+    return listener->keys.empty() ? 0 : std::chrono::duration<double, std::milli>(listener->found_at - t0).count();
+}
+
+static void bench_start_latency(SearchSession& session) {
+    std::vector<double> pool, fresh;
+    for (int i = 0; i < 30; ++i) {
+        pool.push_back(start_to_first_key_ms(session, false));
+        fresh.push_back(start_to_first_key_ms(session, true));
+    }
+    std::sort(pool.begin(), pool.end());
+    std::sort(fresh.begin(), fresh.end());
+    printf("start to first key, worker pool:  median %.2f ms, p95 %.2f ms\n", pool[pool.size() / 2],
+           pool[pool.size() * 95 / 100]);
+    printf("start to first key, new threads:  median %.2f ms, p95 %.2f ms\n", fresh[fresh.size() / 2],
+           fresh[fresh.size() * 95 / 100]);
+}
+
+int main() {
+    SearchSession session(4, nullptr, nullptr);
+    unsigned char target[20];
+    memset(target, 0xAB, sizeof(target));
+    std::mt19937 rng(14);
+
+    for (PubkeyMode mode : {PubkeyMode::Compressed, PubkeyMode::Both}) {
+        std::vector<double> running, paused;
+        for (int i = 0; i < 40; ++i) {
+            auto listener = std::make_shared<RecordingListener>();
+            CHECK(session.start(search_job(session, 1, 1ull << 40, target, mode, listener), STOP_TIMEOUT), "start");
+            std::this_thread::sleep_for(std::chrono::milliseconds(5 + rng() % 25));
+            auto t0 = std::chrono::steady_clock::now();
+            CHECK(session.stop(STOP_TIMEOUT), "stop while running timed out");
+            running.push_back(ms_since(t0));
+            CHECK(listener->wait(STOP_TIMEOUT), "on_finished after stop");
+        }
+        for (int i = 0; i < 20; ++i) {
+            auto listener = std::make_shared<RecordingListener>();
+            CHECK(session.start(search_job(session, 1, 1ull << 40, target, mode, listener), STOP_TIMEOUT), "start");
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            session.pause();
+            std::this_thread::sleep_for(std::chrono::milliseconds(30 + rng() % 40));
+            auto t0 = std::chrono::steady_clock::now();
+            CHECK(session.stop(STOP_TIMEOUT), "stop while paused timed out");
+            paused.push_back(ms_since(t0));
+            CHECK(listener->wait(STOP_TIMEOUT), "on_finished after stop");
+        }
+        const char* name = mode == PubkeyMode::Both ? "both formats" : "compressed";
+        printf("[%s]\n", name);
+        report("stop while running:", running);
+        report("stop while paused:", paused);
+    }
+    check_stops_when_all_found(session);
+    check_both_formats(session);
+    bench_start_latency(session);
+    return test_result("search_session_test");
+}
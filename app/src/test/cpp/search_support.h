@@ -0,0 +1,59 @@
+#pragma once
+
+// بحث حقيقي عبر SearchSession في الاختبارات: مستمع ينتظر on_finished ويجمع المفاتيح الموجودة،
+// ومهمة لنطاق 64-بت وقائمة أهداف أو هدف hash160 واحد
+
+#include "search_session.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct RecordingListener : SearchListener {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool finished = false;
+    std::vector<U256> keys;
+    std::vector<std::string> formats;       // صيغة كل مفتاح في keys
+
+    void on_key_found(const U256& key, const char* format, size_t) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        keys.push_back(key);
+        formats.push_back(format);
+    }
+    void on_finished() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        cv.notify_all();
+    }
+    bool wait(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, timeout, [this] { return finished; });
+    }
+};
+
+static inline SearchJob search_job(SearchSession& session, uint64_t first, uint64_t last,
+                                   const std::vector<TargetSpec>& specs, PubkeyMode mode,
+                                   std::shared_ptr<SearchListener> listener) {
+    SearchJob job;
+    job.table = GeneratorTable::open_or_build("");
+    job.scheduler = std::make_shared<RangeScheduler>(u256_from_u64(first), u256_from_u64(last),
+                                                     u256_from_u64(65536), session.workers());
+    job.targets = std::make_shared<const TargetSet>(specs.data(), specs.size());
+    job.pubkey_mode = mode;
+    job.group_size = 1024;
+    job.progress_interval = std::chrono::milliseconds(200);
+    job.listener = std::move(listener);
+    return job;
+}
+
+static inline SearchJob search_job(SearchSession& session, uint64_t first, uint64_t last,
+                                   const unsigned char hash160[20], PubkeyMode mode,
+                                   std::shared_ptr<SearchListener> listener) {
+    TargetSpec spec;
+    spec.kind = TargetKind::KeyHash;
+    memcpy(spec.digest, hash160, HASH160_LEN);
+    return search_job(session, first, last, std::vector<TargetSpec>{spec}, mode, std::move(listener));
+}
@@ -0,0 +1,92 @@
+// مرجع المفاتيح العامة هو EC_POINT_mul من OpenSSL: k*G بالضرب المباشر، ثم المشي بإضافة G
+// مفتاحًا بعد مفتاح، بالصيغتين المضغوطة وغير المضغوطة. ثم مفتاح/ث للطريقتين جنبًا إلى جنب
+// (مع hash160 في الحالتين كما في البحث)
+
+#include "hash_mb.h"
+#include "oracle.h"
+#include "secp256k1.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+static void check_point(const AffinePoint& p, const U256& k, const char* what) {
+    unsigned char ours[65], want[65];
+    ec_serialize_compressed(p, ours);
+    oracle_pubkey(k, true, want);
+    CHECK(memcmp(ours, want, 33) == 0, "%s compressed, k.d[0]=%016llx", what, (unsigned long long)k.d[0]);
+    ec_serialize_uncompressed(p, ours);
+    oracle_pubkey(k, false, want);
+    CHECK(memcmp(ours, want, 65) == 0, "%s uncompressed, k.d[0]=%016llx", what, (unsigned long long)k.d[0]);
+}
+
+int main() {
+    std::mt19937_64 rng(5);
+
+    // المفاتيح الصغيرة و n-1 ومفاتيح عشوائية بعرض 256 بت
+    std::vector<U256> keys;
+    for (uint64_t k = 1; k <= 8; ++k) keys.push_back(u256_from_u64(k));
+    U256 n_minus_1;
+    u256_sub(n_minus_1, SECP256K1_N, u256_from_u64(1));
+    keys.push_back(n_minus_1);
+    while (keys.size() < 300) {
+        U256 k = {{rng(), rng(), rng(), rng()}};
+        if (!u256_is_zero(k) && u256_cmp(k, SECP256K1_N) < 0) keys.push_back(k);
+    }
+    for (const U256& k : keys) {
+        AffinePoint p;
+        ec_mul_generator(p, k);
+        check_point(p, k, "k*G");
+    }
+
+    // المشي: P(k+1) = P(k) + G، بما فيه الإضافة إلى G نفسها (مضاعفة)
+    for (U256 k : {u256_from_u64(1), U256{{rng(), rng(), rng(), 0x7fffull}}}) {
+        AffinePoint p;
+        ec_mul_generator(p, k);
+        for (int i = 0; i < 2000; ++i) {
+            check_point(p, k, "walk");
+            ec_affine_add(p, p, SECP256K1_G);
+            u256_add_u64(k, k, 1);
+        }
+    }
+    printf("%zu scalar multiplications and 4000 walk steps compared with EC_POINT_mul\n", keys.size());
+
+    // كل مفتاح بضرب كامل مقابل إضافة G واحدة، والتجزئة في الحالتين بدفعات من 64
+    const SimdBackend backend = simd_best_backend();
+    unsigned char pubkeys[64][33];
+    const unsigned char* msgs[64];
+    for (int i = 0; i < 64; ++i) msgs[i] = pubkeys[i];
+    unsigned char digests[64][20];
+    const U256 base = {{0x9a3c5e7f11223344ull, 0x55aa33cc77ee1100ull, 0x0123456789abcdefull, 0x3fedcba987654321ull}};
+
+    const int PER_KEY = 64 * 40, WALK = 64 * 2000;
+    double t0 = thread_cpu_seconds();
+    for (int i = 0; i < PER_KEY; i += 64) {
+        for (int b = 0; b < 64; ++b) {
+            U256 k;
+            u256_add_u64(k, base, (uint64_t)(i + b));
+            AffinePoint p;
+            ec_mul_generator(p, k);
+            ec_serialize_compressed(p, pubkeys[b]);
+        }
+        hash160_mb(backend, msgs, 33, 64, digests);
+    }
+    double per_key = PER_KEY / (thread_cpu_seconds() - t0);
+
+    AffinePoint p;
+    ec_mul_generator(p, base);
+    t0 = thread_cpu_seconds();
+    for (int i = 0; i < WALK; i += 64) {
+        for (int b = 0; b < 64; ++b) {
+            ec_serialize_compressed(p, pubkeys[b]);
+            ec_affine_add(p, p, SECP256K1_G);
+        }
+        hash160_mb(backend, msgs, 33, 64, digests);
+    }
+    double incremental = WALK / (thread_cpu_seconds() - t0);
+    printf("per-key k*G: %.0f keys/s, incremental P+G: %.0f keys/s (x%.1f)\n", per_key, incremental,
+           incremental / per_key);
+
+    return test_result("secp256k1_test");
+}
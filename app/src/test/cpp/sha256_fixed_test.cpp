@@ -0,0 +1,67 @@
+// SHA-256 المخصص بطول ثابت لكل طول في البحث (32 و 33 و 65): نفس ناتج SHA256() من OpenSSL
+// والنسخة العامة sha256_mb_hash، ثم رسالة/ث للثلاثة على مسار واحد
+
+#include "sha256_fixed.h"
+#include "test_support.h"
+
+#include <openssl/sha.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static const size_t MESSAGES = 4096;
+
+template <class Fn>
+static double rate(Fn fn) {
+    double best = 1e9;
+    for (int rep = 0; rep < 7; ++rep) {
+        double t0 = thread_cpu_seconds();
+        for (int it = 0; it < 50; ++it) fn();
+        best = std::min(best, thread_cpu_seconds() - t0);
+    }
+    return MESSAGES * 50 / best / 1e6;
+}
+
+template <size_t LEN>
+static void run(std::mt19937& rng) {
+    std::vector<unsigned char> data(MESSAGES * LEN);
+    for (unsigned char& c : data) c = (unsigned char)rng();
+    std::vector<unsigned char> fixed(MESSAGES * 32), generic(MESSAGES * 32), openssl(MESSAGES * 32);
+
+    for (size_t i = 0; i < MESSAGES; ++i) {
+        const unsigned char* msgs[1] = {&data[i * LEN]};
+        sha256_fixed<LEN>(msgs[0], &fixed[i * 32]);
+        VecScalar s[8];
+        sha256_mb_hash(msgs, LEN, s);
+        sha256_mb_store(s, (unsigned char (*)[32]) & generic[i * 32]);
+        SHA256(msgs[0], LEN, &openssl[i * 32]);
+        CHECK(memcmp(&fixed[i * 32], &openssl[i * 32], 32) == 0, "fixed len=%zu msg=%zu", LEN, i);
+        CHECK(memcmp(&generic[i * 32], &openssl[i * 32], 32) == 0, "generic len=%zu msg=%zu", LEN, i);
+    }
+
+    double r_openssl = rate([&] {
+        for (size_t i = 0; i < MESSAGES; ++i) SHA256(&data[i * LEN], LEN, &openssl[i * 32]);
+    });
+    double r_generic = rate([&] {
+        for (size_t i = 0; i < MESSAGES; ++i) {
+            const unsigned char* msgs[1] = {&data[i * LEN]};
+            VecScalar s[8];
+            sha256_mb_hash(msgs, LEN, s);
+            sha256_mb_store(s, (unsigned char (*)[32]) & generic[i * 32]);
+        }
+    });
+    double r_fixed = rate([&] {
+        for (size_t i = 0; i < MESSAGES; ++i) sha256_fixed<LEN>(&data[i * LEN], &fixed[i * 32]);
+    });
+    printf("len %2zu (%zu blocks): OpenSSL %.2f, generic %.2f, fixed %.2f Mmsg/s (x%.2f vs OpenSSL)\n", LEN,
+           Sha256FixedShape<LEN>::BLOCKS, r_openssl, r_generic, r_fixed, r_fixed / r_openssl);
+}
+
+int main() {
+    std::mt19937 rng(4);
+    run<32>(rng);
+    run<33>(rng);
+    run<65>(rng);
+    return test_result("sha256_fixed_test");
+}
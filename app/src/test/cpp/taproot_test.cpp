@@ -0,0 +1,137 @@
+// P2TR بلا شجرة سكربتات مقابل تعريف BIP-341 مباشرة:
+//   - tap_tweak_mb لكل نواة (المبدوء من حالة كتلة الوسم) يساوي tagged_hash("TapTweak", x) كاملًا
+//   - أول عنوان استلام في BIP-86 لعبارة الاختبار ("abandon ... about"، m/86'/0'/0'/0/0): مفتاحه الداخلي
+//     بـ y فردي، فيمر بنفي P، ويُوجد بعنوانه bc1p... في نطاق صغير حوله
+//   - مفاتيح ناتجة من OpenSSL لمفاتيح بزوجيتي y، كلها تُوجد في مكانها
+// ثم مفاتيح/ث لهدف P2TR بجانب P2PKH
+
+#include "oracle.h"
+#include "pipeline_support.h"
+#include "target_decode.h"
+#include "test_support.h"
+
+#include <random>
+
+static const SimdBackend BACKENDS[] = {SimdBackend::Scalar, SimdBackend::SSE41, SimdBackend::AVX2, SimdBackend::NEON};
+
+// BIP-86: المفتاح الخاص والمفتاح الداخلي والـ tweak والعنوان
+static const char* BIP86_KEY = "41f41d69260df4cf277826a9b65a3717e4eeddbeedf637f212ca096576479361";
+static const char* BIP86_INTERNAL = "cc8a4bc64d897bddc5fbc2f670f7a8ba0b386779106cf1223c6fc5d7cd6fc115";
+static const char* BIP86_ADDRESS = "bc1p5cyxnuxmeuwuvkwfem96lqzszd02n6xdcjrs20cac6yqjjwudpxqkedrcr";
+
+static void from_hex(const char* hex, unsigned char* out, size_t len) {
+    for (size_t i = 0; i < len; ++i) sscanf(hex + 2 * i, "%2hhx", &out[i]);
+}
+
+static void check_tweaks(std::mt19937& rng) {
+    unsigned char internal[32];
+    from_hex(BIP86_INTERNAL, internal, 32);
+    for (SimdBackend backend : BACKENDS) {
+        if (!simd_backend_available(backend)) continue;
+        for (size_t count : {1, 3, 7, 8, 13, 64}) {
+            std::vector<unsigned char> xs(count * 32);
+            for (unsigned char& c : xs) c = (unsigned char)rng();
+            memcpy(&xs[(count / 2) * 32], internal, 32);
+            std::vector<const unsigned char*> msgs(count);
+            for (size_t i = 0; i < count; ++i) msgs[i] = &xs[i * 32];
+            std::vector<unsigned char> tweaks(count * 32);
+            tap_tweak_mb(backend, msgs.data(), count, (unsigned char (*)[32])tweaks.data());
+            for (size_t i = 0; i < count; ++i) {
+                unsigned char want[32];
+                oracle_tap_tweak(msgs[i], want);
+                CHECK(memcmp(want, &tweaks[i * 32], 32) == 0, "%s tweak count=%zu lane=%zu",
+                      simd_backend_name(backend), count, i);
+            }
+        }
+    }
+}
+
+static void check_bip86(const GeneratorTable& table) {
+    U256 key;
+    u256_from_hex(BIP86_KEY, 64, key);
+    // المفتاح الداخلي من المحرك، و y فردي (فيُنفى P قبل الـ tweak)
+    AffinePoint p;
+    ec_mul_generator(p, key);
+    unsigned char x[32], internal[32];
+    fe_to_be_bytes(p.x, x);
+    from_hex(BIP86_INTERNAL, internal, 32);
+    CHECK(memcmp(x, internal, 32) == 0, "BIP-86 internal key");
+    CHECK(fe_is_odd(p.y), "BIP-86 internal key should have odd y");
+
+    TargetSpec spec;
+    CHECK(decode_target(BIP86_ADDRESS, spec) && spec.kind == TargetKind::TaprootOutput, "decode %s", BIP86_ADDRESS);
+    unsigned char want[32];
+    oracle_taproot_output(key, want);
+    CHECK(memcmp(want, spec.digest, 32) == 0, "OpenSSL output key differs from the BIP-86 address");
+
+    // المفتاح في منتصف الدفعة الثانية من نطاق 4 دفعات
+    U256 first;
+    u256_sub(first, key, u256_from_u64(1500));
+    auto targets = std::make_shared<const TargetSet>(&spec, 1);
+    for (PubkeyMode mode : {PubkeyMode::Compressed, PubkeyMode::Uncompressed, PubkeyMode::Both}) {
+        for (bool generic : {false, true}) {
+            SearchPipeline pipeline(table, 1024, mode, targets, simd_best_backend(),
+                                    generic ? generic_stages() : default_pipeline_stages());
+            std::vector<RangeHit> hits = pipeline_hits(pipeline, first, 4096);
+            CHECK(hits.size() == 1 && hits[0].key == 1500 && hits[0].format == "taproot" && hits[0].target == 0,
+                  "BIP-86 key, mode %d, %s: %zu hits", (int)mode, generic ? "run_stages" : "kernel", hits.size());
+        }
+    }
+}
+
+static void check_parities(const GeneratorTable& table, std::mt19937_64& rng) {
+    // 48 مفتاحًا في نطاق 8 دفعات عند بداية عشوائية بعرض 256 بت
+    const U256 first = {{rng(), rng(), rng(), rng() >> 2}};
+    std::vector<uint64_t> offsets;
+    std::vector<TargetSpec> specs;
+    size_t odd = 0;
+    while (offsets.size() < 48) {
+        const uint64_t offset = rng() % 8192;
+        if (std::find(offsets.begin(), offsets.end(), offset) != offsets.end()) continue;
+        U256 k;
+        u256_add_u64(k, first, offset);
+        unsigned char pubkey[33], output[32];
+        oracle_pubkey(k, true, pubkey);
+        odd += pubkey[0] == 0x03;
+        oracle_taproot_output(k, output);
+        offsets.push_back(offset);
+        specs.push_back(target_spec(TargetKind::TaprootOutput, output));
+    }
+    CHECK(odd > 0 && odd < offsets.size(), "keys of one parity only (%zu odd)", odd);
+
+    auto targets = std::make_shared<const TargetSet>(specs.data(), specs.size());
+    for (bool generic : {false, true}) {
+        SearchPipeline pipeline(table, 1024, PubkeyMode::Compressed, targets, simd_best_backend(),
+                                generic ? generic_stages() : default_pipeline_stages());
+        std::vector<RangeHit> hits = pipeline_hits(pipeline, first, 8192);
+        CHECK(hits.size() == offsets.size(), "%s: %zu of %zu output keys found", generic ? "run_stages" : "kernel",
+              hits.size(), offsets.size());
+        for (const RangeHit& hit : hits) {
+            CHECK(hit.target < offsets.size() && offsets[hit.target] == hit.key, "target %zu at offset %llu",
+                  hit.target, (unsigned long long)hit.key);
+        }
+    }
+    printf("%zu BIP-341 output keys (%zu with odd internal y) found at their keys\n", offsets.size(), odd);
+}
+
+static void bench_taproot(const GeneratorTable& table) {
+    const uint64_t KEYS = 1 << 17;
+    unsigned char digest[32];
+    memset(digest, 0x5c, sizeof(digest));
+    const double p2pkh = keys_per_second(table, PubkeyMode::Compressed, {target_spec(TargetKind::KeyHash, digest)}, KEYS);
+    const double p2tr =
+        keys_per_second(table, PubkeyMode::Compressed, {target_spec(TargetKind::TaprootOutput, digest)}, KEYS);
+    printf("%llu keys: P2PKH %.0f keys/s, P2TR %.0f keys/s (x%.2f)\n", (unsigned long long)KEYS, p2pkh, p2tr,
+           p2tr / p2pkh);
+}
+
+int main() {
+    std::mt19937 rng(24);
+    std::mt19937_64 rng64(86);
+    std::shared_ptr<const GeneratorTable> table = GeneratorTable::open_or_build("");
+    check_tweaks(rng);
+    check_bip86(*table);
+    check_parities(*table, rng64);
+    bench_taproot(*table);
+    return test_result("taproot_test");
+}
@@ -0,0 +1,227 @@
+// فك الأهداف بمتجهات منشورة: Base58Check لـ P2PKH و P2SH-P2WPKH، ومتجهات BIP-173 و BIP-350
+// الصالحة وغير الصالحة (checksum خاطئ، حروف مختلطة، bech32 لإصدار 1 و bech32m لإصدار 0،
+// إصدار أو طول أو حشو غير صالح)، ثم المفاتيح العامة بالست عشري.
+// وأخيرًا ما كانت تكلفه مقارنة العنوان لكل مفتاح قبل فك الهدف مرة واحدة (SHA-256 مزدوج و Base58 ومقارنة
+// نصوص) مقابل مقارنة 20 بايت، ومفاتيح/ث للبحث الحالي معها ودونها
+
+#include "pipeline_support.h"
+#include "target_decode.h"
+#include "test_support.h"
+
+#include <openssl/sha.h>
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+static std::string hex_of(const unsigned char* data, size_t len) {
+    static const char* digits = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < len; ++i) {
+        out += digits[data[i] >> 4];
+        out += digits[data[i] & 15];
+    }
+    return out;
+}
+
+struct SegwitVector {
+    const char* address;
+    int version;
+    const char* program;    // nullptr: غير صالح
+};
+
+static const SegwitVector SEGWIT_VECTORS[] = {
+    // BIP-173 و BIP-350، الصالحة للشبكة الرئيسية
+    {"BC1QW508D6QEJXTDG4Y5R3ZARVARY0C5XW7KV8F3T4", 0, "751e76e8199196d454941c45d1b3a323f1433bd6"},
+    {"bc1qrp33g0q5c5txsp9arysrx4k6zdkfs4nce4xj0gdcccefvpysxf3qccfmv3", 0,
+     "1863143c14c5166804bd19203356da136c985678cd4d27a1b8c6329604903262"},
+    {"bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kt5nd6y", 1,
+     "751e76e8199196d454941c45d1b3a323f1433bd6751e76e8199196d454941c45d1b3a323f1433bd6"},
+    {"BC1SW50QGDZ25J", 16, "751e"},
+    {"bc1zw508d6qejxtdg4y5r3zarvaryvaxxpcs", 2, "751e76e8199196d454941c45d1b3a323"},
+    {"bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqzk5jj0", 1,
+     "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"},
+    // غير الصالحة
+    {"bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5", 0, nullptr},     // checksum خاطئ
+    {"bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kV8f3t4", 0, nullptr},     // حروف مختلطة
+    {"bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqh2y7hd", 0, nullptr},    // bech32 لإصدار 1
+    {"BC1S0XLXVLHEMJA6C4DQV22UAPCTQUPFHLXM9H8Z3K2E72Q4K9HCZ7VQ54WELL", 0, nullptr},    // bech32 لإصدار 16
+    {"bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kemeawh", 0, nullptr},     // bech32m لإصدار 0
+    {"bc1p38j9r5y49hruaue7wxjce0updqjuyyx0kh56v8s25huc6995vvpql3jow4", 0, nullptr},    // حرف خارج الأبجدية
+    {"BC130XLXVLHEMJA6C4DQV22UAPCTQUPFHLXM9H8Z3K2E72Q4K9HCZ7VQ7ZWS8R", 0, nullptr},    // إصدار 17
+    {"bc1pw5dgrnzv", 0, nullptr},                                   // برنامج من بايت واحد
+    {"bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7v8n0nx0muaewav253zgeav", 0, nullptr},  // 41 بايت
+    {"BC1QR508D6QEJXTDG4Y5R3ZARVARYV98GJ9P", 0, nullptr},           // الإصدار 0 ببرنامج 16 بايت
+    {"bc1zw508d6qejxtdg4y5r3zarvaryvqyzf3du", 0, nullptr},          // حشو غير صفري
+    {"bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7v07qwwzcrf", 0, nullptr},  // حشو أطول من 4 بت
+    {"bc1gmk9yu", 0, nullptr},                                      // بلا بيانات
+    {"tb1qw508d6qejxtdg4y5r3zarvary0c5xw7kxpjzsx", 0, nullptr},     // شبكة الاختبار
+};
+
+struct TargetVector {
+    const char* address;
+    bool valid;
+    TargetKind kind;
+    const char* digest;
+};
+
+static const TargetVector TARGET_VECTORS[] = {
+    // المفتاح الخاص 1: P2PKH المضغوط وغير المضغوط، و P2WPKH و P2SH-P2WPKH و P2TR بمفتاح ناتج G.x
+    {"1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH", true, TargetKind::KeyHash, "751e76e8199196d454941c45d1b3a323f1433bd6"},
+    {"1EHNa6Q4Jz2uvNExL497mE43ikXhwF6kZm", true, TargetKind::KeyHash, "91b24bf9f5288532960ac687abb035127b1d28a5"},
+    {"bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4", true, TargetKind::WitnessKeyHash,
+     "751e76e8199196d454941c45d1b3a323f1433bd6"},
+    {"3JvL6Ymt8MVWiCNHC7oWU6nLeHNJKLZGLN", true, TargetKind::ScriptHash, "bcfeb728b584253d5f3f70bcb780e9ef218a68f4"},
+    {"bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqzk5jj0", true, TargetKind::TaprootOutput,
+     "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"},
+    // عنوان كتلة التكوين، وعنوان BIP-86 الأول لعبارة الاختبار
+    {"1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", true, TargetKind::KeyHash, "62e907b15cbf27d5425399ebf6f0fb50ebb88f18"},
+    {"bc1p5cyxnuxmeuwuvkwfem96lqzszd02n6xdcjrs20cac6yqjjwudpxqkedrcr", true, TargetKind::TaprootOutput,
+     "a60869f0dbcf1dc659c9cecbaf8050135ea9e8cdc487053f1dc6880949dc684c"},
+    // checksum خاطئ، حرف خارج Base58، إصدار شبكة الاختبار، P2WSH و P2TR بطول آخر غير مدعومين
+    {"1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMJ", false, TargetKind::KeyHash, nullptr},
+    {"1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAM0", false, TargetKind::KeyHash, nullptr},
+    {"mipcBbFg9gMiCh81Kj8tqqdgoZub1ZJRfn", false, TargetKind::KeyHash, nullptr},
+    {"bc1qrp33g0q5c5txsp9arysrx4k6zdkfs4nce4xj0gdcccefvpysxf3qccfmv3", false, TargetKind::KeyHash, nullptr},
+    {"bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kt5nd6y", false, TargetKind::KeyHash,
+     nullptr},
+    {"", false, TargetKind::KeyHash, nullptr},
+};
+
+static void check_segwit() {
+    for (const SegwitVector& v : SEGWIT_VECTORS) {
+        int version = -1;
+        std::vector<unsigned char> program;
+        const bool ok = decode_segwit_address(v.address, version, program);
+        if (v.program == nullptr) {
+            CHECK(!ok, "%s accepted", v.address);
+            continue;
+        }
+        CHECK(ok, "%s rejected", v.address);
+        if (!ok) continue;
+        CHECK(version == v.version, "%s version %d", v.address, version);
+        CHECK(hex_of(program.data(), program.size()) == v.program, "%s program %s", v.address,
+              hex_of(program.data(), program.size()).c_str());
+    }
+}
+
+static void check_base58() {
+    // بايت الإصدار كما هو، ولا يقبل طول حمولة غير 21 بايت (مفتاح WIF المضغوط 34 بايت)
+    unsigned char version = 0xff, digest[HASH160_LEN];
+    CHECK(decode_base58check_hash160("mipcBbFg9gMiCh81Kj8tqqdgoZub1ZJRfn", version, digest) && version == 0x6f,
+          "testnet version byte %02x", version);
+    CHECK(hex_of(digest, HASH160_LEN) == "243f1394f44554f4ce3fd68649c19adc483ce924", "testnet hash160");
+    CHECK(!decode_base58check_hash160("KwDiBf89QgGbjEhKnhXJuH7LrciVrZi3qYjgd9M7rFU73sVHnoWn", version, digest),
+          "WIF key accepted as an address");
+    std::vector<unsigned char> raw;
+    CHECK(base58_decode("1111", raw) && raw == std::vector<unsigned char>(4, 0), "leading zeroes");
+    CHECK(!base58_decode("1l", raw), "'l' is outside the alphabet");
+}
+
+static void check_targets() {
+    for (const TargetVector& v : TARGET_VECTORS) {
+        TargetSpec spec;
+        const bool ok = decode_target(v.address, spec);
+        CHECK(ok == v.valid, "%s: decode_target returned %d", v.address, ok);
+        if (!ok || !v.valid) continue;
+        CHECK(spec.kind == v.kind, "%s kind %d", v.address, (int)spec.kind);
+        CHECK(hex_of(spec.digest, target_digest_len(spec.kind)) == v.digest, "%s digest", v.address);
+    }
+}
+
+static void check_public_keys() {
+    const std::string gx = "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798";
+    const std::string gy = "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
+    const std::string p = "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f";
+    TargetSpec spec;
+    // زوجية y من البادئة أو من y نفسه (y لـ G زوجي)، وبالحروف الكبيرة أيضًا
+    for (const char* prefix : {"02", "03"}) {
+        CHECK(decode_target(prefix + gx, spec), "%s G.x", prefix);
+        CHECK(spec.kind == TargetKind::PublicKey && hex_of(spec.digest, 32) == gx, "%s G.x digest", prefix);
+        CHECK(spec.digest[32] == (prefix[1] == '3' ? 1 : 0), "%s parity", prefix);
+    }
+    CHECK(decode_target("04" + gx + gy, spec) && spec.digest[32] == 0 && hex_of(spec.digest, 32) == gx, "04 G");
+    std::string upper = "02" + gx;
+    for (char& c : upper) c = (char)toupper(c);
+    CHECK(decode_target(upper, spec), "upper-case hex");
+
+    // x = 5: 5³ + 7 ليس مربعًا، فلا نقطة به
+    const std::string x5 = std::string(63, '0') + "5";
+    CHECK(!decode_public_key("02" + x5, spec), "off-curve x accepted");
+    std::string bad_y = gy;
+    bad_y[63] = '9';
+    CHECK(!decode_public_key("04" + gx + bad_y, spec), "04 with y off the curve accepted");
+    CHECK(!decode_public_key("02" + p, spec), "x = p accepted");
+    CHECK(!decode_public_key("04" + gx, spec), "04 with x only accepted");
+    CHECK(!decode_public_key("05" + gx, spec), "prefix 05 accepted");
+    CHECK(!decode_public_key("02" + gx.substr(0, 62), spec), "short key accepted");
+}
+
+// المسار القديم لكل مفتاح: checksum ثم Base58 بالقسمة المتكررة على 58 ثم مقارنة النص بالهدف
+static bool old_address_equals(const unsigned char hash160[HASH160_LEN], const std::string& target) {
+    static const char* alphabet = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    unsigned char payload[25] = {0x00}, check[32];
+    memcpy(payload + 1, hash160, HASH160_LEN);
+    SHA256(payload, 21, check);
+    SHA256(check, 32, check);
+    memcpy(payload + 21, check, 4);
+    std::string out;
+    std::vector<unsigned char> digits(payload, payload + sizeof(payload));
+    size_t begin = 0;
+    for (; begin < digits.size() && digits[begin] == 0; ++begin) out += alphabet[0];
+    std::string tail;
+    while (begin < digits.size()) {
+        int rem = 0;
+        for (size_t i = begin; i < digits.size(); ++i) {
+            const int v = rem * 256 + digits[i];
+            digits[i] = (unsigned char)(v / 58);
+            rem = v % 58;
+        }
+        tail += alphabet[rem];
+        while (begin < digits.size() && digits[begin] == 0) ++begin;
+    }
+    out.append(tail.rbegin(), tail.rend());
+    return out == target;
+}
+
+static void bench_per_key_compare() {
+    const std::string address = "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH";
+    TargetSpec spec;
+    CHECK(decode_target(address, spec), "decode %s", address.c_str());
+    unsigned char digest[HASH160_LEN];
+    memcpy(digest, spec.digest, HASH160_LEN);
+    CHECK(old_address_equals(digest, address), "old compare does not match its own address");
+
+    const int KEYS = 200000;
+    size_t old_equal = 0, raw_equal = 0;
+    double t0 = thread_cpu_seconds();
+    for (int i = 0; i < KEYS; ++i) {
+        digest[i % HASH160_LEN] ^= (unsigned char)i;
+        old_equal += old_address_equals(digest, address);
+    }
+    const double old_ns = (thread_cpu_seconds() - t0) * 1e9 / KEYS;
+    memcpy(digest, spec.digest, HASH160_LEN);
+    t0 = thread_cpu_seconds();
+    for (int i = 0; i < KEYS; ++i) {
+        digest[i % HASH160_LEN] ^= (unsigned char)i;
+        raw_equal += memcmp(digest, spec.digest, HASH160_LEN) == 0;
+    }
+    const double raw_ns = (thread_cpu_seconds() - t0) * 1e9 / KEYS;
+    // نفس تسلسل البصمات، فالطريقتان تتفقان في كل مفتاح يعود فيه الهدف
+    CHECK(old_equal == raw_equal && raw_equal > 0, "old compare matched %zu times, hash160 compare %zu", old_equal,
+          raw_equal);
+
+    std::shared_ptr<const GeneratorTable> table = GeneratorTable::open_or_build("");
+    const double now = keys_per_second(*table, PubkeyMode::Compressed, {spec}, 1 << 17);
+    printf("per key: address compare %.0f ns, hash160 compare %.1f ns\n", old_ns, raw_ns);
+    printf("search now %.0f keys/s, with the old per-key compare %.0f keys/s\n", now, 1e9 / (1e9 / now + old_ns));
+}
+
+int main() {
+    check_segwit();
+    check_base58();
+    check_targets();
+    check_public_keys();
+    bench_per_key_compare();
+    return test_result("target_decode_test");
+}
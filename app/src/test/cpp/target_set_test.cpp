@@ -0,0 +1,132 @@
+// TargetSet لكل نوع ملخص: N ملخصًا عشوائيًا (مع مكررات، وملخصات تشترك في البادئة 16-بت، وأخرى
+// تشترك في أول 20 بايت وتختلف في البقية للأنواع الأطول)، ثم find لكل هدف ولملخصات قريبة وبعيدة لا تطابق.
+// الأنواع الفارغة ترفض كل شيء بلا فهرس، و single و fingerprint كما يتوقعهما الخط ونقطة الاستئناف.
+// ثم كلفة find وحدها ومفاتيح/ث للنواة بـ 1 و 16 و 1024 و 4096 هدفًا
+
+#include "pipeline_support.h"
+#include "target_set.h"
+#include "test_support.h"
+
+#include <random>
+
+static const TargetKind KINDS[] = {TargetKind::KeyHash, TargetKind::ScriptHash, TargetKind::TaprootOutput,
+                                   TargetKind::PublicKey, TargetKind::WitnessKeyHash};
+
+static TargetSpec random_spec(TargetKind kind, std::mt19937_64& rng) {
+    TargetSpec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.kind = kind;
+    for (size_t i = 0; i < target_digest_len(kind); ++i) spec.digest[i] = (unsigned char)rng();
+    return spec;
+}
+
+static void check_kind(TargetKind kind, size_t n, std::mt19937_64& rng) {
+    const size_t len = target_digest_len(kind);
+    std::vector<TargetSpec> specs;
+    for (size_t i = 0; i < n; ++i) {
+        TargetSpec spec = random_spec(kind, rng);
+        // كل خامس يشارك سابقه البادئة 16-بت، وكل سابع يشاركه أول 20 بايت (الأنواع الأطول)
+        if (i > 0 && i % 5 == 0) memcpy(spec.digest, specs[i - 1].digest, 2);
+        if (i > 0 && i % 7 == 0 && len > HASH160_LEN) memcpy(spec.digest, specs[i - 1].digest, HASH160_LEN);
+        specs.push_back(spec);
+    }
+    // مكررات في آخر المدخلات: يبقى رقم أول ظهور
+    const size_t distinct = specs.size();
+    for (size_t i = 0; i < n / 10 + 1 && n > 0; ++i) specs.push_back(specs[rng() % distinct]);
+
+    TargetSet set(specs.data(), specs.size());
+    CHECK(set.size() == distinct, "kind %d n=%zu: size %zu", (int)kind, n, set.size());
+    CHECK(set.id_limit() == specs.size(), "kind %d n=%zu: id_limit %zu", (int)kind, n, set.id_limit());
+    for (TargetKind other : KINDS) CHECK(set.has(other) == (other == kind && n > 0), "kind %d has(%d)", (int)kind, (int)other);
+
+    for (size_t i = 0; i < specs.size(); ++i) {
+        const unsigned char* d = specs[i].digest;
+        const int want = (int)(i < distinct ? i : std::find_if(specs.begin(), specs.end(), [&](const TargetSpec& s) {
+                                                      return memcmp(s.digest, d, len) == 0;
+                                                  }) - specs.begin());
+        CHECK(set.find(kind, d) == want, "kind %d n=%zu: find target %zu = %d, expected %d", (int)kind, n, i,
+              set.find(kind, d), want);
+        CHECK(set.maybe(kind, ((uint32_t)d[0] << 8) | d[1]), "kind %d: prefix bit of target %zu", (int)kind, i);
+        // آخر بايت وأول بايت بعد البادئة مختلفان: لا يطابق
+        for (size_t pos : {len - 1, (size_t)2, HASH160_LEN - 1}) {
+            TargetSpec near = specs[i];
+            near.digest[pos] ^= 0x01;
+            bool listed = false;
+            for (const TargetSpec& s : specs) listed |= memcmp(s.digest, near.digest, len) == 0;
+            if (!listed) CHECK(set.find(kind, near.digest) == -1, "kind %d: near miss of %zu at byte %zu", (int)kind, i, pos);
+        }
+        // الأنواع الأخرى فارغة: لا فهرس، ورفض قبل أي قراءة له
+        for (TargetKind other : KINDS) {
+            if (other != kind) CHECK(set.find(other, d) == -1, "kind %d digest found as kind %d", (int)kind, (int)other);
+        }
+    }
+    size_t false_hits = 0;
+    for (int i = 0; i < 20000; ++i) {
+        TargetSpec miss = random_spec(kind, rng);
+        false_hits += set.find(kind, miss.digest) >= 0;
+    }
+    CHECK(false_hits == 0, "kind %d n=%zu: %zu random digests matched", (int)kind, n, false_hits);
+
+    unsigned char digest[TARGET_DIGEST_MAX];
+    int id = -1;
+    CHECK(set.single(kind, digest, id) == (distinct == 1), "kind %d n=%zu: single", (int)kind, n);
+    if (distinct == 1) CHECK(id == 0 && memcmp(digest, specs[0].digest, len) == 0, "kind %d: single digest", (int)kind);
+}
+
+static void check_fingerprint(std::mt19937_64& rng) {
+    // هدف P2PKH واحد: بصمته ملخصه نفسه (نقاط الاستئناف القديمة)، والقوائم لا تتأثر بترتيب الإدخال
+    TargetSpec one = random_spec(TargetKind::KeyHash, rng);
+    unsigned char a[HASH160_LEN], b[HASH160_LEN];
+    TargetSet(&one, 1).fingerprint(a);
+    CHECK(memcmp(a, one.digest, HASH160_LEN) == 0, "single P2PKH fingerprint");
+
+    std::vector<TargetSpec> specs;
+    for (TargetKind kind : KINDS) specs.push_back(random_spec(kind, rng));
+    specs.push_back(one);
+    TargetSet(specs.data(), specs.size()).fingerprint(a);
+    std::reverse(specs.begin(), specs.end());
+    specs.push_back(specs[1]);
+    TargetSet(specs.data(), specs.size()).fingerprint(b);
+    CHECK(memcmp(a, b, HASH160_LEN) == 0, "fingerprint depends on input order or duplicates");
+    // نفس الملخص بنوع آخر هدف آخر
+    TargetSpec witness = one;
+    witness.kind = TargetKind::WitnessKeyHash;
+    TargetSpec pair_a[2] = {one, random_spec(TargetKind::KeyHash, rng)}, pair_b[2] = {witness, pair_a[1]};
+    TargetSet(pair_a, 2).fingerprint(a);
+    TargetSet(pair_b, 2).fingerprint(b);
+    CHECK(memcmp(a, b, HASH160_LEN) != 0, "fingerprint ignores the target kind");
+
+    TargetSet empty(nullptr, 0);
+    CHECK(empty.size() == 0 && empty.find(TargetKind::KeyHash, one.digest) == -1, "empty set");
+}
+
+static void bench(const GeneratorTable& table, std::mt19937_64& rng) {
+    const uint64_t KEYS = 1 << 18;
+    for (size_t n : {1, 16, 1024, 4096}) {
+        std::vector<TargetSpec> specs;
+        for (size_t i = 0; i < n; ++i) specs.push_back(random_spec(TargetKind::KeyHash, rng));
+        // find وحده على ملخصات عشوائية (كلها ترفض): ns لكل بحث
+        TargetSet set(specs.data(), specs.size());
+        std::vector<unsigned char> probes(65536 * HASH160_LEN);
+        for (unsigned char& c : probes) c = (unsigned char)rng();
+        int sink = 0;
+        const double t0 = thread_cpu_seconds();
+        for (int rep = 0; rep < 32; ++rep)
+            for (size_t i = 0; i < 65536; ++i) sink += set.find(TargetKind::KeyHash, &probes[i * HASH160_LEN]);
+        const double ns = (thread_cpu_seconds() - t0) * 1e9 / (32 * 65536);
+        CHECK(sink == -32 * 65536, "random probe matched");
+        const double rate = keys_per_second(table, PubkeyMode::Compressed, specs, KEYS);
+        printf("%5zu targets: find %.2f ns/lookup, kernel %.0f keys/s\n", n, ns, rate);
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(21);
+    for (TargetKind kind : KINDS) {
+        for (size_t n : {0, 1, 2, 17, 1000, 5000}) check_kind(kind, n, rng);
+    }
+    check_fingerprint(rng);
+    std::shared_ptr<const GeneratorTable> table = GeneratorTable::open_or_build("");
+    bench(*table, rng);
+    return test_result("target_set_test");
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// أدوات صغيرة مشتركة بين الاختبارات: فحص يعدّ الأخطاء دون أن يوقف الاختبار، ووقت المعالج للخيط
+// (أثبت من الوقت الفعلي على أجهزة مشتركة)، ومجلد مؤقت لملفات المحرك، وعملية فرعية لإعادة فتحها
+
+#include <ftw.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+static int g_failures = 0;
+
+#define CHECK(cond, ...)                                             \
+    do {                                                             \
+        if (!(cond)) {                                               \
+            ++g_failures;                                            \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed: ", __FILE__, __LINE__, #cond); \
+            fprintf(stderr, __VA_ARGS__);                            \
+            fprintf(stderr, "\n");                                   \
+        }                                                            \
+    } while (0)
+
+static inline double thread_cpu_seconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// /tmp/<name>_XXXXXX جديد
+static inline std::string make_temp_dir(const char* name) {
+    std::string tmpl = std::string("/tmp/") + name + "_XXXXXX";
+    return mkdtemp(&tmpl[0]);
+}
+
+// المجلد وكل ما تحته
+static inline void remove_tree(const std::string& dir) {
+    nftw(dir.c_str(), [](const char* path, const struct stat*, int, struct FTW*) { return remove(path); }, 16,
+         FTW_DEPTH | FTW_PHYS);
+}
+
+// fn في عملية فرعية تُحسب أخطاؤها هنا: المحرك يخزن ما يفتحه لكل مسار داخل العملية
+// (ResultSink و GeneratorTable)، فإعادة الفتح من الملف تحتاج عملية أخرى
+template <class Fn>
+static void in_child(Fn fn) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        fn();
+        fflush(stdout);
+        _exit(g_failures == 0 ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0, "child failed (status %d)", status);
+}
+
+static inline int test_result(const char* name) {
+    if (g_failures == 0) printf("%s: OK\n", name);
+    else printf("%s: %d failures\n", name, g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+// حساب U256 عند حدوده، ثم تقسيم نطاق البحث إلى قطع كما يفعل startSearchNative:
+//   - u256_from_hex: فارغ، خانة واحدة، 64 خانة، 65 خانة (مرفوض)، أحرف غير ست عشرية، وقيم >= n
+//     يقرؤها المحلل كما هي ويرفضها شرط النطاق (end < n)، مع ذهاب وإياب عبر u256_to_hex
+//   - المحمول والاستلاف عبر الخانات الأربع، و u256_mul_u64 مع خانة الفيضان
+//   - u256_divmod مقابل __int128 و q*b + rem = a لقيم بعرض 256 بت، ومنها a < b و a = b و b = 1
+//   - range_chunk_keys لنطاقات قرب 2^255: القطع متجاورة وتغطي النطاق، وعددها لا يتجاوز CHECKPOINT_MAX_CHUNKS،
+//     وطولها مضاعف لحجم المجموعة
+
+#include "range_scheduler.h"
+#include "search_checkpoint.h"
+#include "secp256k1.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+
+static const uint64_t GROUP = 1024, CHUNK_BATCHES = 16;
+static const U256 U256_MAX = {{~0ull, ~0ull, ~0ull, ~0ull}};
+
+static bool parse(const std::string& hex, U256& out) { return u256_from_hex(hex.data(), hex.size(), out); }
+
+static bool equal(const U256& a, const U256& b) { return u256_cmp(a, b) == 0; }
+
+static void check_hex() {
+    U256 v;
+    CHECK(!parse("", v), "empty string parsed");
+    CHECK(parse("0", v) && u256_is_zero(v), "\"0\"");
+    CHECK(parse("F", v) && equal(v, u256_from_u64(15)), "\"F\"");
+    CHECK(parse(std::string(64, 'f'), v) && equal(v, U256_MAX), "64 digits");
+    CHECK(parse("1" + std::string(63, '0'), v) && equal(v, U256{{0, 0, 0, 1ull << 60}}), "top digit");
+    CHECK(!parse(std::string(65, '0'), v), "65 zeros parsed");
+    CHECK(!parse("1" + std::string(64, '0'), v), "65 digits parsed");
+    for (const char* bad : {"0x1", "g", " 1", "1 ", "-1", "12345678z"}) {
+        CHECK(!parse(bad, v), "\"%s\" parsed", bad);
+    }
+
+    // n و n-1 و n+1 وأكبر قيمة: المحلل يقبلها، وشرط النطاق يرفض كل ما >= n
+    const char* N_HEX = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141";
+    CHECK(parse(N_HEX, v) && equal(v, SECP256K1_N), "n");
+    U256 n_minus_1, n_plus_1;
+    u256_sub(n_minus_1, SECP256K1_N, u256_from_u64(1));
+    u256_add_u64(n_plus_1, SECP256K1_N, 1);
+    CHECK(parse("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140", v) && equal(v, n_minus_1) &&
+              u256_cmp(v, SECP256K1_N) < 0,
+          "n-1 is a valid range end");
+    CHECK(parse("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364142", v) && equal(v, n_plus_1) &&
+              u256_cmp(v, SECP256K1_N) > 0,
+          "n+1 is past the range end");
+    CHECK(parse(std::string(64, 'F'), v) && u256_cmp(v, SECP256K1_N) > 0, "2^256-1 is past the range end");
+
+    std::mt19937_64 rng(20);
+    for (int i = 0; i < 1000; ++i) {
+        const U256 a = {{rng(), rng(), rng(), rng()}};
+        char hex[65];
+        u256_to_hex(a, hex);
+        CHECK(strlen(hex) == 64 && parse(hex, v) && equal(v, a), "hex round trip %s", hex);
+    }
+}
+
+static void check_carries() {
+    U256 r;
+    CHECK(u256_add(r, U256_MAX, u256_from_u64(1)) == 1 && u256_is_zero(r), "max + 1");
+    CHECK(u256_add_u64(r, U256{{~0ull, ~0ull, 0, 0}}, 1) == 0 && equal(r, U256{{0, 0, 1, 0}}),
+          "carry across two limbs");
+    CHECK(u256_add_u64(r, U256{{~0ull, ~0ull, ~0ull, 0x7fffffffffffffffull}}, 1) == 0 &&
+              equal(r, U256{{0, 0, 0, 1ull << 63}}),
+          "carry into the top bit");
+    CHECK(u256_add(r, U256_MAX, U256_MAX) == 1 && equal(r, U256{{~0ull - 1, ~0ull, ~0ull, ~0ull}}), "max + max");
+    CHECK(u256_sub(r, u256_from_u64(0), u256_from_u64(1)) == 1 && equal(r, U256_MAX), "0 - 1");
+    CHECK(u256_sub(r, U256{{0, 0, 0, 1}}, u256_from_u64(1)) == 0 && equal(r, U256{{~0ull, ~0ull, ~0ull, 0}}),
+          "borrow across three limbs");
+
+    uint64_t carry;
+    CHECK(addc64(~0ull, ~0ull, 1, &carry) == ~0ull && carry == 1, "addc64 max + max + 1");
+    CHECK(subb64(0, ~0ull, 1, &carry) == 0 && carry == 1, "subb64 0 - max - 1");
+
+    CHECK(u256_mul_u64(r, U256_MAX, 2) == 1 && equal(r, U256{{~0ull - 1, ~0ull, ~0ull, ~0ull}}), "max * 2");
+    CHECK(u256_mul_u64(r, U256{{0, 0, 0, 1ull << 63}}, 4) == 2 && u256_is_zero(r), "2^255 * 4");
+}
+
+// q*b + rem = a و rem < b، حين b بخانة واحدة أو q بخانة واحدة
+static void check_divmod_identity(const U256& a, const U256& b) {
+    U256 q, rem, back;
+    u256_divmod(a, b, q, rem);
+    CHECK(u256_cmp(rem, b) < 0, "remainder not below the divisor");
+    uint64_t overflow;
+    if (u256_fits_u64(b)) {
+        overflow = u256_mul_u64(back, q, b.d[0]);
+    } else {
+        CHECK(u256_fits_u64(q), "quotient wider than expected");
+        overflow = u256_mul_u64(back, b, q.d[0]);
+    }
+    const uint64_t carry = u256_add(back, back, rem);
+    CHECK(overflow == 0 && carry == 0 && equal(back, a), "q*b + rem != a for a.d[3]=%016llx b.d[0]=%016llx",
+          (unsigned long long)a.d[3], (unsigned long long)b.d[0]);
+}
+
+static void check_divmod() {
+    std::mt19937_64 rng(200);
+    U256 q, rem;
+    for (int i = 0; i < 2000; ++i) {
+        const uint128_t a = ((uint128_t)rng() << 64) | rng();
+        const uint128_t b =
+            (i & 1) ? (uint128_t)(rng() >> (i % 64)) + 1 : (((uint128_t)rng() << 64) | rng()) >> (i % 128);
+        if (b == 0) continue;
+        u256_divmod(U256{{(uint64_t)a, (uint64_t)(a >> 64), 0, 0}}, U256{{(uint64_t)b, (uint64_t)(b >> 64), 0, 0}},
+                    q, rem);
+        const uint128_t want_q = a / b, want_r = a % b;
+        CHECK(equal(q, U256{{(uint64_t)want_q, (uint64_t)(want_q >> 64), 0, 0}}) &&
+                  equal(rem, U256{{(uint64_t)want_r, (uint64_t)(want_r >> 64), 0, 0}}),
+              "128-bit divmod differs from __int128");
+    }
+    for (int i = 0; i < 500; ++i) {
+        const U256 a = {{rng(), rng(), rng(), rng()}};
+        check_divmod_identity(a, u256_from_u64((rng() >> (i % 64)) | 1));
+        check_divmod_identity(a, U256{{rng(), rng(), rng(), (rng() >> (i % 64)) | 1}});
+    }
+
+    const U256 a = {{rng(), rng(), rng(), rng() >> 1}};
+    u256_divmod(a, U256_MAX, q, rem);
+    CHECK(u256_is_zero(q) && equal(rem, a), "a < b");
+    u256_divmod(U256_MAX, U256_MAX, q, rem);
+    CHECK(equal(q, u256_from_u64(1)) && u256_is_zero(rem), "a = b");
+    u256_divmod(U256_MAX, u256_from_u64(1), q, rem);
+    CHECK(equal(q, U256_MAX) && u256_is_zero(rem), "b = 1");
+    u256_divmod(U256_MAX, U256{{0, 0, 0, 1ull << 63}}, q, rem);
+    CHECK(equal(q, u256_from_u64(1)) && equal(rem, U256{{~0ull, ~0ull, ~0ull, 0x7fffffffffffffffull}}),
+          "max / 2^255");
+}
+
+// [start, start + span] بالطول الذي يختاره startSearchNative
+static void check_chunking(const U256& start, const U256& span, const char* what) {
+    U256 end;
+    u256_add(end, start, span);
+    const U256 chunk_keys = range_chunk_keys(start, end, GROUP * CHUNK_BATCHES, GROUP, CHECKPOINT_MAX_CHUNKS);
+    U256 groups, rem;
+    u256_divmod(chunk_keys, u256_from_u64(GROUP), groups, rem);
+    CHECK(u256_is_zero(rem), "%s: chunk length is not a multiple of the group size", what);
+    CHECK(u256_cmp(chunk_keys, u256_from_u64(GROUP * CHUNK_BATCHES)) >= 0, "%s: chunk shorter than the default",
+          what);
+
+    RangeScheduler s(start, end, chunk_keys, 4);
+    const uint64_t count = s.chunk_count();
+    // نقطة الاستئناف تقبل حتى CHECKPOINT_MAX_CHUNKS قطعة
+    CHECK(count >= 1 && count <= CHECKPOINT_MAX_CHUNKS, "%s: %llu chunks", what, (unsigned long long)count);
+    // الطول الأصغر بمجموعة واحدة يتجاوز الحد، ما لم يكن الطول الافتراضي
+    if (u256_cmp(chunk_keys, u256_from_u64(GROUP * CHUNK_BATCHES)) > 0) {
+        U256 shorter, chunks;
+        u256_sub(shorter, chunk_keys, u256_from_u64(GROUP));
+        u256_divmod(span, shorter, chunks, rem);
+        CHECK(!u256_fits_u64(chunks) || chunks.d[0] + 1 > CHECKPOINT_MAX_CHUNKS,
+              "%s: a shorter chunk would also fit", what);
+    }
+
+    // القطع الأولى والأخيرة متجاورة، والأخيرة تنتهي عند end، و chunk_index يعيد كل مفتاح إلى قطعته
+    CHECK(equal(s.chunk(0).first, start), "%s: first chunk does not start at the range start", what);
+    CHECK(equal(s.chunk(count - 1).last, end), "%s: last chunk does not end at the range end", what);
+    for (uint64_t i : {(uint64_t)0, (uint64_t)1, count / 2, count >= 2 ? count - 2 : 0}) {
+        if (i + 1 >= count) continue;
+        U256 next;
+        u256_add_u64(next, s.chunk(i).last, 1);
+        CHECK(equal(next, s.chunk(i + 1).first), "%s: gap after chunk %llu", what, (unsigned long long)i);
+        CHECK(s.chunk_index(s.chunk(i).last) == i && s.chunk_index(next) == i + 1, "%s: chunk_index at %llu", what,
+              (unsigned long long)i);
+    }
+    CHECK(s.chunk_index(end) == count - 1, "%s: chunk_index of the range end", what);
+}
+
+static void check_ranges_near_2_255() {
+    const U256 two_255 = {{0, 0, 0, 1ull << 63}};
+    U256 start;
+    // مليون مفتاح حول 2^255: طول القطعة الافتراضي، وقطعة أخيرة ناقصة
+    u256_sub(start, two_255, u256_from_u64(500000));
+    check_chunking(start, u256_from_u64(1000000), "1M keys around 2^255");
+    // نطاق ينتهي عند 2^255 - 1 ومفتاح واحد بعده
+    u256_sub(start, two_255, u256_from_u64(GROUP * CHUNK_BATCHES));
+    check_chunking(start, u256_from_u64(GROUP * CHUNK_BATCHES - 1), "one chunk ending at 2^255-1");
+    check_chunking(start, u256_from_u64(GROUP * CHUNK_BATCHES), "one key past one chunk");
+    check_chunking(two_255, u256_from_u64(0), "single key 2^255");
+    // حد CHECKPOINT_MAX_CHUNKS بالضبط وبعده بقليل
+    u256_sub(start, two_255, u256_from_u64(1ull << 40));
+    check_chunking(start, u256_from_u64(CHECKPOINT_MAX_CHUNKS * GROUP * CHUNK_BATCHES - 1), "at the chunk limit");
+    check_chunking(start, u256_from_u64(CHECKPOINT_MAX_CHUNKS * GROUP * CHUNK_BATCHES), "just above the chunk limit");
+    // 2^255 مفتاح من 2^254، والنطاق الكامل [1, n-1]
+    check_chunking(U256{{0, 0, 0, 1ull << 62}}, U256{{~0ull, ~0ull, ~0ull, 0x7fffffffffffffffull}}, "2^255 keys");
+    U256 span;
+    u256_sub(span, SECP256K1_N, u256_from_u64(2));
+    check_chunking(u256_from_u64(1), span, "full range [1, n-1]");
+}
+
+int main() {
+    check_hex();
+    check_carries();
+    check_divmod();
+    check_ranges_near_2_255();
+    return test_result("uint256_test");
+}